@@ -0,0 +1,235 @@
+# SPDX-License-Identifier: MIT
+#
+# Copyright 2023 Michael Rodriguez
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the “Software”),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+
+# Checks object files against a stack budget and a static RAM budget, and
+# checks that they need nothing from the C library which a freestanding
+# environment doesn't provide.
+#
+# This is run as a script, with the following variables defined:
+#
+#   OBJECTS       The object files to check, separated by "|". Each must have
+#                 been compiled with -fstack-usage and -ffunction-sections.
+#   NM            The nm tool of the toolchain which compiled the objects.
+#   OBJDUMP       The objdump tool of the toolchain which compiled the objects.
+#   CALLS         The calls the functions make to each other which can't be
+#                 found in the objects, such as calls through a pointer,
+#                 separated by "|", each written as "caller:callee". A function
+#                 which was inlined has no frame of its own, but the functions
+#                 it calls are still followed.
+#
+# The stack a function needs is its own frame plus the deepest stack of any
+# function it calls. Direct calls are found from the relocations of each
+# function: as every function has a section of its own, even a call to a
+# static function within the same object needs one. A function which takes the
+# address of another is charged as though it called it, which errs on the safe
+# side.
+#   STACK_BUDGET  The most stack any function may need, calls included, in
+#                 bytes.
+#   RAM_BUDGET    The most static RAM (.data and .bss) all of the objects may
+#                 use together, in bytes.
+
+string(REPLACE "|" ";" OBJECTS "${OBJECTS}")
+string(REPLACE "|" ";" CALLS "${CALLS}")
+
+set(FAILED FALSE)
+set(RAM_USED 0)
+set(FUNCTIONS "")
+
+foreach(CALL IN LISTS CALLS)
+  string(REPLACE ":" ";" CALL "${CALL}")
+  list(GET CALL 0 CALLER)
+  list(GET CALL 1 CALLEE)
+  list(APPEND CALLEES_${CALLER} ${CALLEE})
+  list(APPEND FUNCTIONS ${CALLER})
+endforeach()
+
+# Finds the deepest stack a function may need, following the calls it makes.
+# The call graph must not be recursive.
+#
+# FUNCTION  The function to start from.
+# DEPTH     The variable to store the depth in, in bytes.
+# CHAIN     The variable to store the deepest chain of calls in.
+function(stack_depth_find FUNCTION DEPTH CHAIN)
+  set(DEEPEST 0)
+  set(DEEPEST_CHAIN "")
+
+  foreach(CALLEE IN LISTS CALLEES_${FUNCTION})
+    stack_depth_find(${CALLEE} CALLEE_DEPTH CALLEE_CHAIN)
+
+    if (CALLEE_DEPTH GREATER DEEPEST)
+      set(DEEPEST ${CALLEE_DEPTH})
+      set(DEEPEST_CHAIN " -> ${CALLEE_CHAIN}")
+    endif()
+  endforeach()
+
+  if (DEFINED FRAME_SIZE_${FUNCTION})
+    math(EXPR DEEPEST "${DEEPEST} + ${FRAME_SIZE_${FUNCTION}}")
+  endif()
+
+  set(${DEPTH} ${DEEPEST} PARENT_SCOPE)
+  set(${CHAIN} "${FUNCTION}${DEEPEST_CHAIN}" PARENT_SCOPE)
+endfunction()
+
+foreach(OBJECT IN LISTS OBJECTS)
+  # The stack usage file takes the place of the extension of the object file.
+  string(REGEX REPLACE "\\.[^.]*$" ".su" STACK_USAGE_FILE "${OBJECT}")
+
+  if (NOT EXISTS "${STACK_USAGE_FILE}")
+    message(FATAL_ERROR
+            "No stack usage was recorded for ${OBJECT}; was it compiled with "
+            "-fstack-usage?")
+  endif()
+
+  file(STRINGS "${STACK_USAGE_FILE}" FRAMES)
+
+  foreach(FRAME IN LISTS FRAMES)
+    # Each line holds the function, the size of its frame and how the size is
+    # known, separated by tabs.
+    string(REPLACE "\t" ";" FIELDS "${FRAME}")
+    list(GET FIELDS 0 FUNCTION)
+    list(GET FIELDS 1 FRAME_SIZE)
+    list(GET FIELDS 2 QUALIFIERS)
+
+    # The function is named after the source file it came from, and clones of
+    # it made by the compiler carry a suffix such as ".constprop.0"; both are
+    # dropped so that the calls can name it.
+    string(REGEX REPLACE "^.*:" "" FUNCTION "${FUNCTION}")
+    string(REGEX REPLACE "\\..*$" "" FUNCTION "${FUNCTION}")
+
+    if (QUALIFIERS STREQUAL "dynamic")
+      message(NOTICE "${FUNCTION}: the stack frame is unbounded")
+      set(FAILED TRUE)
+    endif()
+
+    # A function cloned more than once is charged for its largest clone.
+    if (NOT DEFINED FRAME_SIZE_${FUNCTION} OR
+        FRAME_SIZE GREATER FRAME_SIZE_${FUNCTION})
+      set(FRAME_SIZE_${FUNCTION} ${FRAME_SIZE})
+    endif()
+
+    list(APPEND FUNCTIONS ${FUNCTION})
+  endforeach()
+
+  execute_process(COMMAND "${NM}" --print-size "${OBJECT}"
+                  OUTPUT_VARIABLE SYMBOLS
+                  RESULT_VARIABLE RESULT)
+
+  if (NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Unable to list the symbols of ${OBJECT}")
+  endif()
+
+  string(REPLACE "\n" ";" SYMBOLS "${SYMBOLS}")
+
+  foreach(SYMBOL IN LISTS SYMBOLS)
+    if (SYMBOL MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) [bBdD] (.+)$")
+      math(EXPR SYMBOL_SIZE "0x${CMAKE_MATCH_1}")
+      math(EXPR RAM_USED "${RAM_USED} + ${SYMBOL_SIZE}")
+      message(STATUS "${CMAKE_MATCH_2}: ${SYMBOL_SIZE} bytes of static RAM")
+    elseif (SYMBOL MATCHES "^ *U (.+)$")
+      set(DEPENDENCY "${CMAKE_MATCH_1}")
+
+      # Besides the compiler runtime and the linker, a freestanding environment
+      # is only expected to provide the memory functions, which the compiler
+      # may emit calls to on its own.
+      if (NOT DEPENDENCY MATCHES
+          "^(_?(memcmp|memcpy|memmove|memset)|__.*|_GLOBAL_OFFSET_TABLE_)$")
+        message(NOTICE "${OBJECT}: depends on ${DEPENDENCY}")
+        set(FAILED TRUE)
+      endif()
+    endif()
+  endforeach()
+endforeach()
+
+# The calls are found once every frame is known, so that calls from one object
+# to another can be followed.
+foreach(OBJECT IN LISTS OBJECTS)
+  execute_process(COMMAND "${OBJDUMP}" --disassemble --reloc "${OBJECT}"
+                  OUTPUT_VARIABLE DISASSEMBLY
+                  RESULT_VARIABLE RESULT)
+
+  if (NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Unable to disassemble ${OBJECT}")
+  endif()
+
+  # Only the start of each function and the relocations are of interest, in
+  # the order they appear.
+  string(REGEX MATCHALL
+         "[0-9a-fA-F]+ <[^>\n]+>:|R_[A-Za-z0-9_]+[ \t]+[^ \t\n]+"
+         DISASSEMBLY "${DISASSEMBLY}")
+
+  set(CALLER "")
+
+  foreach(LINE IN LISTS DISASSEMBLY)
+    if (LINE MATCHES "^[0-9a-fA-F]+ <([^>]+)>:$")
+      string(REGEX REPLACE "\\..*$" "" CALLER "${CMAKE_MATCH_1}")
+    elseif (LINE MATCHES "^R_[A-Za-z0-9_]+[ \t]+(.+)$")
+      # A static function is reached through the section it lives in, and the
+      # addend is dropped along with any clone suffix.
+      string(REGEX REPLACE "^\\.text\\." "" CALLEE "${CMAKE_MATCH_1}")
+      string(REGEX REPLACE "[-+].*$" "" CALLEE "${CALLEE}")
+      string(REGEX REPLACE "\\..*$" "" CALLEE "${CALLEE}")
+
+      # Anything else the function refers to, such as data or the memory
+      # functions, isn't part of the call graph.
+      list(FIND CALLEES_${CALLER} "${CALLEE}" INDEX)
+
+      if (DEFINED FRAME_SIZE_${CALLEE} AND NOT CALLEE STREQUAL CALLER AND
+          INDEX EQUAL -1)
+        list(APPEND CALLEES_${CALLER} ${CALLEE})
+      endif()
+    endif()
+  endforeach()
+endforeach()
+
+list(REMOVE_DUPLICATES FUNCTIONS)
+set(STACK_USED 0)
+set(STACK_CHAIN "")
+
+foreach(FUNCTION IN LISTS FUNCTIONS)
+  stack_depth_find(${FUNCTION} DEPTH CHAIN)
+
+  if (DEPTH GREATER STACK_USED)
+    set(STACK_USED ${DEPTH})
+    set(STACK_CHAIN "${CHAIN}")
+  endif()
+endforeach()
+
+message(STATUS
+        "Stack: ${STACK_USED} bytes, of a budget of ${STACK_BUDGET} bytes, "
+        "through ${STACK_CHAIN}")
+
+if (STACK_USED GREATER STACK_BUDGET)
+  message(NOTICE "The stack used is over budget")
+  set(FAILED TRUE)
+endif()
+
+message(STATUS
+        "Static RAM: ${RAM_USED} bytes, of a budget of ${RAM_BUDGET} bytes")
+
+if (RAM_USED GREATER RAM_BUDGET)
+  message(NOTICE "The static RAM used is over budget")
+  set(FAILED TRUE)
+endif()
+
+if (FAILED)
+  message(FATAL_ERROR "The footprint is over budget")
+endif()
@@ -27,3 +27,22 @@ function(samething_test_add TEST_NAME TEST_SRC LIBS)
 
   gtest_discover_tests(${TEST_NAME})
 endfunction()
+
+# Adds a test which checks the object files of a target against a stack budget
+# and a static RAM budget; see footprint_check.cmake. Any further arguments are
+# calls the functions of the target make to each other which can't be found in
+# its object files, such as calls through a pointer, each written as
+# "caller:callee".
+function(samething_footprint_test_add TEST_NAME TARGET STACK_BUDGET RAM_BUDGET)
+  string(JOIN "|" CALLS ${ARGN})
+
+  add_test(NAME ${TEST_NAME}
+           COMMAND ${CMAKE_COMMAND}
+                   "-DOBJECTS=$<JOIN:$<TARGET_OBJECTS:${TARGET}>,|>"
+                   -DNM=${CMAKE_NM}
+                   -DOBJDUMP=${CMAKE_OBJDUMP}
+                   "-DCALLS=${CALLS}"
+                   -DSTACK_BUDGET=${STACK_BUDGET}
+                   -DRAM_BUDGET=${RAM_BUDGET}
+                   -P ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/footprint_check.cmake)
+endfunction()
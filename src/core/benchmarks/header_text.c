@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "samething/core.h"
+
+/// The number of times each header is parsed and formatted again.
+#define ROUNDS_NUM (1000000)
+
+int main(void) {
+  static const char *const TEXTS[] = {
+      "ZCZC-WXR-TOR-048484-048485+0030-1231200-KEC61/NW-",
+      "ZCZC-EAS-RWT-012057-012081-012101-012103-012115+0100-3650459-WABC/FM -",
+      "ZCZC-CIV-CAE-036061+0600-0011200-NYC/OEM -",
+      "ZCZC-PEP-EAN-000000+0000-1800000-WHITEHSE-"};
+
+  static const size_t TEXTS_NUM = sizeof(TEXTS) / sizeof(TEXTS[0]);
+
+  struct samething_core_header header;
+  char text[SAMETHING_CORE_HEADER_TEXT_LEN_MAX + 1];
+  size_t text_lens[sizeof(TEXTS) / sizeof(TEXTS[0])];
+
+  for (size_t i = 0; i < TEXTS_NUM; ++i) {
+    text_lens[i] = strlen(TEXTS[i]);
+  }
+
+  // Every header is formatted back into text, so that none of the parsing can
+  // be optimized away.
+  size_t total_len = 0;
+
+  for (size_t round = 0; round < ROUNDS_NUM; ++round) {
+    for (size_t i = 0; i < TEXTS_NUM; ++i) {
+      if (samething_core_header_parse(&header, TEXTS[i], text_lens[i], NULL) !=
+          SAMETHING_CORE_PARSE_ERROR_NONE) {
+        return EXIT_FAILURE;
+      }
+      total_len += samething_core_header_format(&header, text);
+    }
+  }
+  return (total_len > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "samething/core.h"
+
+/// The maximum number of worker threads.
+#define WORKERS_NUM_MAX (64)
+
+/// Defines the range of a message a worker thread renders.
+struct worker {
+  const struct samething_core_gen_ctx *ctx;
+  int16_t *dst;
+  size_t start;
+  size_t num_samples;
+};
+
+static int16_t samples[SAMETHING_CORE_MESSAGE_SAMPLES_NUM_MAX];
+
+static void *worker_run(void *const arg) {
+  const struct worker *const worker = arg;
+
+  samething_core_range_render(worker->ctx, worker->start,
+                              &worker->dst[worker->start],
+                              worker->num_samples);
+  return NULL;
+}
+
+int main(void) {
+  struct samething_core_gen_ctx ctx = {};
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .callsign = "BENCH/TE ",
+      .event_code = "EEE",
+      .originator_code = "ORG",
+      .originator_time = "89238993",
+      .valid_time_period = "1234",
+      .attn_sig_duration = 25};
+
+  samething_core_ctx_init(&ctx, &header);
+
+  const size_t num_samples = samething_core_seq_spans_get(&ctx, NULL);
+
+  long num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+
+  if (num_workers < 1) {
+    num_workers = 1;
+  } else if (num_workers > WORKERS_NUM_MAX) {
+    num_workers = WORKERS_NUM_MAX;
+  }
+
+  // Every worker gets its own range of the message, and its own cursor into
+  // the same read-only generation context.
+  pthread_t threads[WORKERS_NUM_MAX];
+  struct worker workers[WORKERS_NUM_MAX];
+
+  const size_t range =
+      (num_samples + (size_t)num_workers - 1) / (size_t)num_workers;
+
+  for (long i = 0; i < num_workers; ++i) {
+    const size_t start = (size_t)i * range;
+
+    const size_t end = (start + range < num_samples) ? (start + range)
+                                                     : num_samples;
+
+    workers[i].ctx = &ctx;
+    workers[i].dst = samples;
+    workers[i].start = start;
+    workers[i].num_samples = (start < end) ? (end - start) : 0;
+
+    if (pthread_create(&threads[i], NULL, worker_run, &workers[i]) != 0) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (long i = 0; i < num_workers; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+
+  return EXIT_SUCCESS;
+}
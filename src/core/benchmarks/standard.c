@@ -25,7 +25,8 @@
 #include "samething/core.h"
 
 int main(void) {
-  struct samething_core_gen_ctx ctx = {};
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
 
   const struct samething_core_header header = {
       .location_codes = {"101010", "828282",
@@ -39,8 +40,8 @@ int main(void) {
 
   samething_core_ctx_init(&ctx, &header);
 
-  while (ctx.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
-    samething_core_samples_gen(&ctx);
+  while (ctx.cursor.seq_state < ctx.seq_plan_size) {
+    samething_core_samples_gen(&ctx, sample_data);
   }
   return EXIT_SUCCESS;
 }
@@ -23,10 +23,19 @@
 /** \file core.c
  * Defines the implementation logic of SAME header generation.
  *
- * The sample rate is fixed at 44100Hz. There appears to be no good reason to
- * go above or below that value. Unfortunately, an authoritative answer is
- * not defined in the specification. Experimentation with various different
- * decoders has not shown any problems.
+ * By default, samples are generated at 44100Hz. There appears to be no good
+ * reason to go above or below that value. Unfortunately, an authoritative
+ * answer is not defined in the specification. Experimentation with various
+ * different decoders has not shown any problems.
+ *
+ * A generation context configured with samething_core_ctx_rate_init() instead
+ * runs at any of SAMETHING_CORE_SAMPLE_RATES, from 8000Hz to 48000Hz. Such a
+ * generation context keeps an exact bit clock: rather than rounding every bit
+ * to a whole number of samples, the bits of a burst follow the exact bit rate
+ * of 520 5/6 bits per second, and each starts on the first sample at or after
+ * its exact start time. Its bits are synthesized as they are reached, and the
+ * oscillator steps for every supported rate are built along with the shared
+ * tables.
  *
  * Single-precision floating point is enforced; double-precision is not
  * necessary, and many embedded systems do not have double precision FPUs.
@@ -34,6 +43,62 @@
  * lead to an increase in code size as the compiler would then have to pull in
  * soft-float routines in addition to incurring a performance penalty.
  *
+ * By default, the phase of each AFSK bit is reset to 0 at the start of the
+ * bit. Every bit is exactly SAMETHING_CORE_AFSK_SAMPLES_PER_BIT samples long,
+ * so there are only two distinct bit waveforms: mark and space.
+ *
+ * samething_core_ctx_init expands the header into a bit plan: a list of runs of
+ * identical bits, each packed into a single byte. The generator walks the plan
+ * rather than the header, so no bits are extracted while generating. A run of
+ * up to SAMETHING_CORE_AFSK_RUN_BITS_MAX mark or space bits is rendered once
+ * into a shared table, and each run in the plan is emitted with a single copy
+ * out of that table.
+ *
+ * Both attention signal frequencies are whole numbers of Hz, so the attention
+ * signal repeats exactly once every second. A single second of it is rendered
+ * once into a shared table, and the attention signal is emitted by copying out
+ * of that table, wrapping around as needed.
+ *
+ * The End of Message (EOM) burst is the same for every message, and its first
+ * SAMETHING_CORE_PREAMBLE_NUM bytes are the preamble which starts every header
+ * burst. Every burst starts from phase 0, so the EOM burst is rendered once
+ * into a shared table, and both the EOM bursts and the preambles are streamed
+ * straight out of it.
+ *
+ * Defining SAMETHING_CORE_AFSK_CONTINUOUS_PHASE instead carries the phase over
+ * from one bit to the next, producing continuous-phase FSK. The waveform of a
+ * bit then depends on every bit before it, so each run of the bit plan is
+ * synthesized into the generation context as it is reached.
+ *
+ * All synthesis goes through a tone kernel, which is a numerically controlled
+ * oscillator: a phasor is rotated by a fixed step for every sample, so no
+ * transcendental function is evaluated per sample. The phasor is anchored from
+ * an exact integer phase accumulator at the start of every call, which keeps
+ * rounding error from building up. Vectorized kernels advance several phasors
+ * at once, each offset from the last by one sample; the fastest kernel the
+ * host CPU supports is selected at runtime, and the scalar kernel remains as
+ * the portable fallback.
+ *
+ * The only sines and cosines evaluated are the ones used to anchor and step
+ * each oscillator. By default they come from the C library; defining
+ * SAMETHING_CORE_FAST_SINE replaces them with short polynomials evaluated on an
+ * exactly reduced integer phase, which removes the dependency on libm. Both are
+ * accurate to within SAMETHING_CORE_SINCOS_ERROR_MAX.
+ *
+ * Targets without an FPU can define SAMETHING_CORE_FIXED_POINT, which replaces
+ * the tone kernels with one that uses integer arithmetic only: the phase
+ * accumulators drive an interpolated Q15 quarter-wave sine table directly, and
+ * tone gains are Q15. Every sample stays within 1.5 of an ideal sine, as it
+ * does on the floating point path, so the two never differ by more than 2.
+ *
+ * Defining SAMETHING_CORE_TINY selects a profile for small microcontrollers.
+ * It implies SAMETHING_CORE_FIXED_POINT, so <math.h> is never needed, and it
+ * drops the shared waveform tables, which take up around 115 KB of RAM and
+ * 9 KB of ROM; each bit and each block of the attention signal is rendered
+ * through the tone kernel as it is reached instead. The samples are the same
+ * as with SAMETHING_CORE_FIXED_POINT alone. samething_core_segments_build(),
+ * which points into the tables, is not available in this profile.
+ *
  * Dynamic memory allocation is forbidden; all sizes are fixed, and all the
  * upper bounds are known at compile time.
  *
@@ -82,285 +147,2467 @@
  * targets, and even on traditional desktop systems this would still be
  * dangerous. Since dynamic memory allocation is off the table, the solution is
  * to generate chunks of audio samples and then push them to the audio device
- * incrementally. In our case, we choose to generate 4,096 samples at a time.
+ * incrementally. In our case, we choose to generate 4,096 samples at a time
+ * by default; SAMETHING_CORE_SAMPLES_NUM_MAX may be defined at build time to
+ * use smaller chunks.
  */
 
 #include "samething/core.h"
 
+#if !defined(SAMETHING_CORE_FAST_SINE) && \
+    !defined(SAMETHING_CORE_FIXED_POINT)
 #include <math.h>
+#endif
+
+#ifndef SAMETHING_CORE_TINY
+#include <stdatomic.h>
+#endif  // SAMETHING_CORE_TINY
+
 #include <string.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_acle.h>
+#include <arm_neon.h>
+#endif
+
 #include "samething/compiler.h"
 #include "samething/debug.h"
+#include "tone.h"
 
 #define SAMETHING_PI 3.141593F
 
-SAMETHING_STATIC void samething_core_field_add(uint8_t *const restrict data,
-                                               size_t *restrict data_size,
-                                               const char *restrict const field,
-                                               const size_t field_len) {
-  SAMETHING_ASSERT(data != NULL);
-  SAMETHING_ASSERT(data_size != NULL);
-  SAMETHING_ASSERT(field != NULL);
-  SAMETHING_ASSERT(field_len > 0);
+/// Converts a phase, where 2^32 is one full cycle, to radians.
+#define SAMETHING_CORE_PHASE_TO_RAD (SAMETHING_PI * 2 / 4294967296.0F)
 
-  // XXX: SAMETHING_CORE_CALLSIGN_LEN is the largest field, if this ever
-  // changes this must change as well.
-  SAMETHING_ASSERT(field_len <= SAMETHING_CORE_CALLSIGN_LEN);
+/// The per-sample phase increment of the AFSK oscillator, indexed by the value
+/// of the bit being generated (0 for space, 1 for mark).
+static const uint32_t SAMETHING_CORE_AFSK_PHASE_INC[2] = {
+    (uint32_t)((SAMETHING_CORE_AFSK_SPACE_FREQ /
+                (float)SAMETHING_CORE_SAMPLE_RATE) *
+               4294967296.0F),
+    (uint32_t)((SAMETHING_CORE_AFSK_MARK_FREQ /
+                (float)SAMETHING_CORE_SAMPLE_RATE) *
+               4294967296.0F)};
 
-  memcpy(&data[*data_size], field, field_len);
-  *data_size += field_len;
-  data[(*data_size)++] = '-';
+/// The exact frequencies of the AFSK oscillator, in Hz, as the numerator and
+/// denominator of a fraction, indexed by the value of the bit being generated
+/// (0 for space, 1 for mark).
+static const uint32_t SAMETHING_CORE_AFSK_FREQ_NUM[2] = {3125U, 6250U};
+static const uint32_t SAMETHING_CORE_AFSK_FREQ_DEN[2] = {2U, 3U};
+
+/// The exact AFSK bit rate, in bits per second, as the numerator and
+/// denominator of a fraction. Every bit is a whole number of cycles of either
+/// frequency.
+#define SAMETHING_CORE_AFSK_BIT_RATE_NUM (3125U)
+#define SAMETHING_CORE_AFSK_BIT_RATE_DEN (6U)
+
+/// The number of sample rates a generation context can be configured to run at.
+#define SAMETHING_CORE_SAMPLE_RATES_NUM (6U)
+
+/// The sample rates a generation context can be configured to run at.
+static const unsigned int
+    SAMETHING_CORE_SAMPLE_RATES[SAMETHING_CORE_SAMPLE_RATES_NUM] = {
+        8000U, 11025U, 16000U, 22050U, 44100U, SAMETHING_CORE_SAMPLE_RATE_MAX};
+
+/// The frequencies of the attention signal, in Hz.
+static const uint32_t SAMETHING_CORE_ATTN_SIG_FREQS[2] = {
+    (uint32_t)SAMETHING_CORE_ATTN_SIG_FREQ_FIRST,
+    (uint32_t)SAMETHING_CORE_ATTN_SIG_FREQ_SECOND};
+
+/// The number of samples after which the attention signal repeats itself.
+///
+/// This holds as long as both attention signal frequencies are whole numbers
+/// of Hz.
+#define SAMETHING_CORE_ATTN_SIG_PERIOD (SAMETHING_CORE_SAMPLE_RATE)
+
+/// The frequency of the NOAA Weather Radio (NWR) attention signal, in Hz.
+#define SAMETHING_CORE_ATTN_SIG_NWR_FREQ_HZ \
+  ((uint32_t)SAMETHING_CORE_ATTN_SIG_NWR_FREQ)
+
+/// The number of samples after which the NOAA Weather Radio (NWR) attention
+/// signal repeats itself, which is exactly one cycle of its tone (42 samples
+/// at 44100 Hz) and divides SAMETHING_CORE_ATTN_SIG_PERIOD evenly.
+#define SAMETHING_CORE_ATTN_SIG_NWR_PERIOD \
+  (SAMETHING_CORE_SAMPLE_RATE / SAMETHING_CORE_ATTN_SIG_NWR_FREQ_HZ)
+
+/// The number of samples of the NWR attention signal which are pre-rendered.
+///
+/// A single cycle is enough for SAMETHING_CORE_TINY. Otherwise, the table has
+/// to be long enough for each segment of a message to be more than a handful of
+/// samples, so it covers a fraction of a second instead (105 cycles at 44100
+/// Hz).
+#ifdef SAMETHING_CORE_TINY
+#define SAMETHING_CORE_ATTN_SIG_NWR_TABLE_SIZE \
+  (SAMETHING_CORE_ATTN_SIG_NWR_PERIOD)
+#else
+#define SAMETHING_CORE_ATTN_SIG_NWR_TABLE_SIZE \
+  (SAMETHING_CORE_ATTN_SIG_PERIOD /            \
+   SAMETHING_CORE_ATTN_SIG_NWR_SEGMENTS_PER_SEC)
+#endif  // SAMETHING_CORE_TINY
+
+/// The End of Message (EOM) burst, which is the same for every message. Its
+/// first SAMETHING_CORE_PREAMBLE_NUM bytes are also the preamble of every
+/// header burst.
+static const uint8_t
+    SAMETHING_CORE_EOM_HEADER[SAMETHING_CORE_EOM_HEADER_SIZE] = {
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        SAMETHING_CORE_PREAMBLE,
+        'N',
+        'N',
+        'N',
+        'N'};
+
+#ifndef SAMETHING_CORE_TINY
+/// The number of samples in the table of silence, which is a fraction of a
+/// second; longer periods of silence are split into repeats of it.
+#define SAMETHING_CORE_SILENCE_TABLE_SIZE \
+  (SAMETHING_CORE_SAMPLE_RATE / SAMETHING_CORE_SILENCE_SEGMENTS_PER_SEC)
+
+/// The table of silence which segments of silence are made of.
+static const int16_t
+    SAMETHING_CORE_SILENCE[SAMETHING_CORE_SILENCE_TABLE_SIZE] = {0};
+#endif  // SAMETHING_CORE_TINY
+
+/// The number of samples in the End of Message (EOM) burst.
+#define SAMETHING_CORE_EOM_SAMPLES_NUM                              \
+  (SAMETHING_CORE_EOM_HEADER_SIZE * SAMETHING_CORE_AFSK_BITS_PER_CHAR * \
+   SAMETHING_CORE_AFSK_SAMPLES_PER_BIT)
+
+#ifdef SAMETHING_CORE_TINY
+/// Whether the oscillator tables have been built.
+///
+/// The tiny profile targets single-core systems without atomics; the first
+/// generation context must be initialized before any others can be used
+/// concurrently.
+static bool samething_core_tables_built;
+#else
+/// Defines the construction states of the shared waveform tables.
+enum samething_core_tables_state {
+  /// The tables have not been built yet.
+  SAMETHING_CORE_TABLES_STATE_UNBUILT,
+
+  /// The tables are being built by some thread.
+  SAMETHING_CORE_TABLES_STATE_BUILDING,
+
+  /// The tables are built and may be read from any thread.
+  SAMETHING_CORE_TABLES_STATE_BUILT
+};
+
+/// The construction state of the shared waveform tables.
+static atomic_int samething_core_tables_state =
+    SAMETHING_CORE_TABLES_STATE_UNBUILT;
+#endif  // SAMETHING_CORE_TINY
+
+/// The tone kernel best suited to the host CPU.
+static samething_core_tone_kernel samething_core_tone_render;
+
+/// The rotation of the AFSK oscillator, indexed by the value of the bit being
+/// generated (0 for space, 1 for mark).
+static struct samething_core_tone_step samething_core_afsk_steps[2];
+
+#ifndef SAMETHING_CORE_TINY
+/// The rotation of each attention signal oscillator.
+static struct samething_core_tone_step samething_core_attn_sig_steps[2];
+#endif  // SAMETHING_CORE_TINY
+
+/// The rotation of the AFSK oscillator at each of SAMETHING_CORE_SAMPLE_RATES,
+/// indexed by the value of the bit being generated (0 for space, 1 for mark).
+static struct samething_core_tone_step
+    samething_core_rate_afsk_steps[SAMETHING_CORE_SAMPLE_RATES_NUM][2];
+
+/// The rotation of each attention signal oscillator at each of
+/// SAMETHING_CORE_SAMPLE_RATES.
+static struct samething_core_tone_step
+    samething_core_rate_attn_sig_steps[SAMETHING_CORE_SAMPLE_RATES_NUM][2];
+
+/// The rotation of the NOAA Weather Radio (NWR) attention signal oscillator at
+/// each of SAMETHING_CORE_SAMPLE_RATES.
+static struct samething_core_tone_step
+    samething_core_rate_attn_sig_nwr_steps[SAMETHING_CORE_SAMPLE_RATES_NUM];
+
+/// The flag marking a run of the bit plan as a run of mark (1) bits.
+#define SAMETHING_CORE_AFSK_RUN_MARK (0x80U)
+
+/// Extracts the number of bits in a run of the bit plan.
+#define SAMETHING_CORE_AFSK_RUN_LEN_MASK (0x7FU)
+
+/// The number of samples in the longest run of the bit plan.
+#define SAMETHING_CORE_AFSK_RUN_SAMPLES_MAX \
+  (SAMETHING_CORE_AFSK_RUN_BITS_MAX * SAMETHING_CORE_AFSK_SAMPLES_PER_BIT)
+
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+/// The phase of the oscillator at the end of each byte of the End of Message
+/// (EOM) burst, where 2^32 is one full cycle.
+static uint32_t
+    samething_core_eom_phases[SAMETHING_CORE_EOM_HEADER_SIZE + 1];
+#elif !defined(SAMETHING_CORE_TINY)
+/// The waveform of the longest run of identical AFSK bits, indexed by the
+/// value of the bit (0 for space, 1 for mark). Every bit starts from phase 0,
+/// so this is a single bit repeated; shorter runs are a prefix of it.
+static int16_t
+    samething_core_afsk_run_table[2][SAMETHING_CORE_AFSK_RUN_SAMPLES_MAX];
+#endif
+
+/// The start of the NOAA Weather Radio (NWR) attention signal. A single cycle
+/// of its tone is rendered, and repeated to fill the rest of the table.
+static int16_t
+    samething_core_attn_sig_nwr_table[SAMETHING_CORE_ATTN_SIG_NWR_TABLE_SIZE];
+
+#ifndef SAMETHING_CORE_TINY
+/// A single period of the attention signal.
+static int16_t samething_core_attn_sig_table[SAMETHING_CORE_ATTN_SIG_PERIOD];
+
+/// The End of Message (EOM) burst, pre-rendered. This doubles as the preamble
+/// of every header burst.
+static int16_t samething_core_eom_table[SAMETHING_CORE_EOM_SAMPLES_NUM];
+#endif  // SAMETHING_CORE_TINY
+
+#ifndef SAMETHING_CORE_FIXED_POINT
+#ifdef SAMETHING_CORE_FAST_SINE
+/// The coefficients of the Taylor series of sin(x), from x^3 to x^7.
+static const float SAMETHING_CORE_SIN_COEFFS[3] = {
+    -1.0F / 6.0F, 1.0F / 120.0F, -1.0F / 5040.0F};
+
+/// The coefficients of the Taylor series of cos(x), from x^2 to x^8.
+static const float SAMETHING_CORE_COS_COEFFS[4] = {
+    -1.0F / 2.0F, 1.0F / 24.0F, -1.0F / 720.0F, 1.0F / 40320.0F};
+#endif  // SAMETHING_CORE_FAST_SINE
+
+SAMETHING_STATIC void samething_core_sincos(const uint32_t phase,
+                                            float *const re, float *const im) {
+#ifdef SAMETHING_CORE_FAST_SINE
+  // Split the phase into the nearest quarter cycle and a remainder of at most
+  // an eighth of a cycle either way. Doing this on the integer phase is exact,
+  // so the polynomials only ever see |x| <= pi/4, where the first term left
+  // out of each series is below 3.2e-7.
+  const uint32_t quadrant = (phase + (UINT32_C(1) << 29)) >> 30;
+  const int32_t rem = (int32_t)(phase - (quadrant << 30));
+
+  const float x = (float)rem * SAMETHING_CORE_PHASE_TO_RAD;
+  const float x2 = x * x;
+
+  const float s =
+      x + (x * x2 *
+           (SAMETHING_CORE_SIN_COEFFS[0] +
+            (x2 * (SAMETHING_CORE_SIN_COEFFS[1] +
+                   (x2 * SAMETHING_CORE_SIN_COEFFS[2])))));
+
+  const float c =
+      1.0F + (x2 * (SAMETHING_CORE_COS_COEFFS[0] +
+                    (x2 * (SAMETHING_CORE_COS_COEFFS[1] +
+                           (x2 * (SAMETHING_CORE_COS_COEFFS[2] +
+                                  (x2 * SAMETHING_CORE_COS_COEFFS[3])))))));
+
+  // Rotate the result back into the quadrant it came from.
+  switch (quadrant & 3U) {
+    case 0:
+      *re = c;
+      *im = s;
+      break;
+
+    case 1:
+      *re = -s;
+      *im = c;
+      break;
+
+    case 2:
+      *re = -c;
+      *im = -s;
+      break;
+
+    default:
+      *re = s;
+      *im = -c;
+      break;
+  }
+#else
+  // Treating the phase as signed keeps the angle within [-pi, pi), which halves
+  // the error picked up converting it.
+  const float angle = (float)(int32_t)phase * SAMETHING_CORE_PHASE_TO_RAD;
+
+  *re = cosf(angle);
+  *im = sinf(angle);
+#endif  // SAMETHING_CORE_FAST_SINE
 }
 
-SAMETHING_STATIC void samething_core_afsk_gen(
-    struct samething_core_gen_ctx *const restrict ctx,
-    const uint8_t *const restrict data, const size_t data_size,
-    const size_t sample_pos) {
-  SAMETHING_ASSERT(ctx != NULL);
-  SAMETHING_ASSERT(data != NULL);
-  SAMETHING_ASSERT(data_size > 0);
+// Hosts with a vector kernel never fall back to this one outside of testing.
+#if defined(SAMETHING_TESTING) || (!defined(__SSE2__) && !defined(__ARM_NEON))
+/// Converts a sample to a signed 16-bit integer, clamping it to the range of
+/// the type.
+///
+/// @param sample The sample to convert, where INT16_MAX is full scale.
+/// @returns The converted sample.
+static SAMETHING_ALWAYS_INLINE int16_t
+samething_core_sample_saturate(const float sample) {
+  if (sample >= (float)INT16_MAX) {
+    return INT16_MAX;
+  }
 
-  // ~9.50% of time in this function is spent on this operation.
-  const float freq = ((data[ctx->afsk.data_pos] >> ctx->afsk.bit_pos) & 1)
-                         ? SAMETHING_CORE_AFSK_MARK_FREQ
-                         : SAMETHING_CORE_AFSK_SPACE_FREQ;
+  if (sample <= (float)INT16_MIN) {
+    return INT16_MIN;
+  }
+  return (int16_t)sample;
+}
 
-  const float t =
-      (float)ctx->afsk.sample_num / (float)SAMETHING_CORE_SAMPLE_RATE;
+SAMETHING_STATIC void samething_core_tone_render_scalar(
+    int16_t *const restrict dst, const size_t num_samples,
+    const struct samething_core_tone *const restrict tones,
+    const size_t num_tones) {
+  SAMETHING_ASSERT(dst != NULL);
+  SAMETHING_ASSERT(num_samples <= SAMETHING_CORE_TONE_RENDER_MAX);
+  SAMETHING_ASSERT(tones != NULL);
 
-  const int16_t sample =
-      (int16_t)(sinf(SAMETHING_PI * 2 * t * freq) * INT16_MAX);
-  ctx->sample_data[sample_pos] = sample;
+  float acc[SAMETHING_CORE_TONE_RENDER_MAX] = {0};
 
-  ctx->afsk.sample_num++;
+  for (size_t tone = 0; tone < num_tones; ++tone) {
+    const struct samething_core_tone_step *const step = tones[tone].step;
+    const float gain = tones[tone].gain;
 
-  if (ctx->afsk.sample_num >= SAMETHING_CORE_AFSK_SAMPLES_PER_BIT) {
-    ctx->afsk.sample_num = 0;
-    ctx->afsk.bit_pos++;
+    float re;
+    float im;
+    samething_core_sincos(tones[tone].phase, &re, &im);
 
-    if (ctx->afsk.bit_pos >= SAMETHING_CORE_AFSK_BITS_PER_CHAR) {
-      ctx->afsk.bit_pos = 0;
-      ctx->afsk.data_pos++;
+    for (size_t i = 0; i < num_samples; ++i) {
+      acc[i] += im * gain;
 
-      if (ctx->afsk.data_pos >= data_size) {
-        // By the time we get here, we're completely done caring about the AFSK
-        // state for the current state; clear it to prepare for the next one.
-        memset(&ctx->afsk, 0, sizeof(ctx->afsk));
-      }
+      const float next_re = (re * step->re[1]) - (im * step->im[1]);
+      im = (re * step->im[1]) + (im * step->re[1]);
+      re = next_re;
     }
   }
+
+  for (size_t i = 0; i < num_samples; ++i) {
+    dst[i] = samething_core_sample_saturate(acc[i] * INT16_MAX);
+  }
 }
+#endif  // defined(SAMETHING_TESTING) || no vector kernel
 
-SAMETHING_STATIC void samething_core_silence_gen(
-    struct samething_core_gen_ctx *const restrict ctx,
-    const size_t sample_pos) {
-  SAMETHING_ASSERT(ctx != NULL);
-  ctx->sample_data[sample_pos] = 0;
+#ifdef __SSE2__
+SAMETHING_STATIC void samething_core_tone_render_sse2(
+    int16_t *const restrict dst, const size_t num_samples,
+    const struct samething_core_tone *const restrict tones,
+    const size_t num_tones) {
+  SAMETHING_ASSERT(dst != NULL);
+  SAMETHING_ASSERT(num_samples <= SAMETHING_CORE_TONE_RENDER_MAX);
+  SAMETHING_ASSERT(tones != NULL);
+
+  _Alignas(16) float acc[SAMETHING_CORE_TONE_RENDER_MAX] = {0};
+
+  for (size_t tone = 0; tone < num_tones; ++tone) {
+    const struct samething_core_tone_step *const step = tones[tone].step;
+
+    float anchor_re;
+    float anchor_im;
+    samething_core_sincos(tones[tone].phase, &anchor_re, &anchor_im);
+
+    // Lane k starts at the anchor rotated k times, and every lane advances by
+    // 4 samples per iteration.
+    const __m128 ar = _mm_set1_ps(anchor_re);
+    const __m128 ai = _mm_set1_ps(anchor_im);
+    const __m128 pr = _mm_loadu_ps(step->re);
+    const __m128 pi = _mm_loadu_ps(step->im);
+
+    __m128 re = _mm_sub_ps(_mm_mul_ps(ar, pr), _mm_mul_ps(ai, pi));
+    __m128 im = _mm_add_ps(_mm_mul_ps(ar, pi), _mm_mul_ps(ai, pr));
+
+    const __m128 sr = _mm_set1_ps(step->re[4]);
+    const __m128 si = _mm_set1_ps(step->im[4]);
+    const __m128 gain = _mm_set1_ps(tones[tone].gain);
+
+    for (size_t i = 0; i < num_samples; i += 4) {
+      _mm_store_ps(&acc[i],
+                   _mm_add_ps(_mm_load_ps(&acc[i]), _mm_mul_ps(im, gain)));
+
+      const __m128 next_re = _mm_sub_ps(_mm_mul_ps(re, sr), _mm_mul_ps(im, si));
+      im = _mm_add_ps(_mm_mul_ps(re, si), _mm_mul_ps(im, sr));
+      re = next_re;
+    }
+  }
+
+  // Truncate to 32-bit integers like a scalar cast would, then narrow to 16
+  // bits; the narrowing saturates.
+  const __m128 scale = _mm_set1_ps(INT16_MAX);
+  _Alignas(16) int16_t out[SAMETHING_CORE_TONE_RENDER_MAX];
+
+  for (size_t i = 0; i < num_samples; i += 8) {
+    const __m128i lo =
+        _mm_cvttps_epi32(_mm_mul_ps(_mm_load_ps(&acc[i]), scale));
+    const __m128i hi =
+        _mm_cvttps_epi32(_mm_mul_ps(_mm_load_ps(&acc[i + 4]), scale));
+
+    _mm_store_si128((__m128i *)(void *)&out[i], _mm_packs_epi32(lo, hi));
+  }
+  memcpy(dst, out, num_samples * sizeof(int16_t));
 }
+#endif  // __SSE2__
 
-SAMETHING_STATIC void samething_core_attn_sig_gen(
-    struct samething_core_gen_ctx *const restrict ctx,
-    const size_t sample_pos) {
-  SAMETHING_ASSERT(ctx != NULL);
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) SAMETHING_STATIC void
+samething_core_tone_render_avx2(
+    int16_t *const restrict dst, const size_t num_samples,
+    const struct samething_core_tone *const restrict tones,
+    const size_t num_tones) {
+  SAMETHING_ASSERT(dst != NULL);
+  SAMETHING_ASSERT(num_samples <= SAMETHING_CORE_TONE_RENDER_MAX);
+  SAMETHING_ASSERT(tones != NULL);
+
+  _Alignas(32) float acc[SAMETHING_CORE_TONE_RENDER_MAX] = {0};
+
+  for (size_t tone = 0; tone < num_tones; ++tone) {
+    const struct samething_core_tone_step *const step = tones[tone].step;
+
+    float anchor_re;
+    float anchor_im;
+    samething_core_sincos(tones[tone].phase, &anchor_re, &anchor_im);
 
-  const float t =
-      (float)ctx->attn_sig_sample_num / (float)SAMETHING_CORE_SAMPLE_RATE;
+    // Lane k starts at the anchor rotated k times, and every lane advances by
+    // 8 samples per iteration.
+    const __m256 ar = _mm256_set1_ps(anchor_re);
+    const __m256 ai = _mm256_set1_ps(anchor_im);
+    const __m256 pr = _mm256_loadu_ps(step->re);
+    const __m256 pi = _mm256_loadu_ps(step->im);
 
-  const float calc = SAMETHING_PI * 2 * t;
+    __m256 re = _mm256_sub_ps(_mm256_mul_ps(ar, pr), _mm256_mul_ps(ai, pi));
+    __m256 im = _mm256_add_ps(_mm256_mul_ps(ar, pi), _mm256_mul_ps(ai, pr));
 
-  const float first_freq =
-      sinf(calc * SAMETHING_CORE_ATTN_SIG_FREQ_FIRST) / sizeof(int16_t);
+    const __m256 sr = _mm256_set1_ps(step->re[8]);
+    const __m256 si = _mm256_set1_ps(step->im[8]);
+    const __m256 gain = _mm256_set1_ps(tones[tone].gain);
 
-  const float second_freq =
-      sinf(calc * SAMETHING_CORE_ATTN_SIG_FREQ_SECOND) / sizeof(int16_t);
+    for (size_t i = 0; i < num_samples; i += 8) {
+      _mm256_store_ps(&acc[i], _mm256_add_ps(_mm256_load_ps(&acc[i]),
+                                             _mm256_mul_ps(im, gain)));
 
-  ctx->sample_data[sample_pos] =
-      (int16_t)((first_freq + second_freq) * INT16_MAX);
-  ctx->attn_sig_sample_num++;
+      const __m256 next_re =
+          _mm256_sub_ps(_mm256_mul_ps(re, sr), _mm256_mul_ps(im, si));
+      im = _mm256_add_ps(_mm256_mul_ps(re, si), _mm256_mul_ps(im, sr));
+      re = next_re;
+    }
+  }
+
+  // Truncate to 32-bit integers like a scalar cast would, then narrow to 16
+  // bits; the narrowing saturates. The narrowing works on each 128-bit half
+  // independently, so the 64-bit quarters have to be put back in order.
+  const __m256 scale = _mm256_set1_ps(INT16_MAX);
+  _Alignas(32) int16_t out[SAMETHING_CORE_TONE_RENDER_MAX];
+
+  for (size_t i = 0; i < num_samples; i += 16) {
+    const __m256i lo =
+        _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_load_ps(&acc[i]), scale));
+    const __m256i hi =
+        _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_load_ps(&acc[i + 8]), scale));
+
+    _mm256_store_si256(
+        (__m256i *)(void *)&out[i],
+        _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8));
+  }
+  memcpy(dst, out, num_samples * sizeof(int16_t));
 }
+#endif  // defined(__x86_64__) || defined(__i386__)
 
-void samething_core_ctx_init(
-    struct samething_core_gen_ctx *const restrict ctx,
-    const struct samething_core_header *const restrict header) {
-  SAMETHING_ASSERT(ctx != NULL);
-  SAMETHING_ASSERT(header != NULL);
+#ifdef __ARM_NEON
+SAMETHING_STATIC void samething_core_tone_render_neon(
+    int16_t *const restrict dst, const size_t num_samples,
+    const struct samething_core_tone *const restrict tones,
+    const size_t num_tones) {
+  SAMETHING_ASSERT(dst != NULL);
+  SAMETHING_ASSERT(num_samples <= SAMETHING_CORE_TONE_RENDER_MAX);
+  SAMETHING_ASSERT(tones != NULL);
 
-  static const uint8_t SAMETHING_CORE_INITIAL_HEADER[] = {
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      SAMETHING_CORE_PREAMBLE,
-      'Z',
-      'C',
-      'Z',
-      'C',
-      '-',
-      'O',
-      'R',
-      'G',
-      '-',
-      'E',
-      'E',
-      'E',
-      '-',
-      'P',
-      'S',
-      'S',
-      'C',
-      'C',
-      'C'};
+  _Alignas(16) float acc[SAMETHING_CORE_TONE_RENDER_MAX] = {0};
 
-  memcpy(&ctx->header_data, SAMETHING_CORE_INITIAL_HEADER,
-         sizeof(SAMETHING_CORE_INITIAL_HEADER));
+  for (size_t tone = 0; tone < num_tones; ++tone) {
+    const struct samething_core_tone_step *const step = tones[tone].step;
 
-  // We want to start populating the fields after the first dash.
-  ctx->header_size =
-      SAMETHING_CORE_PREAMBLE_NUM + SAMETHING_CORE_ASCII_ID_LEN + 1;
+    float anchor_re;
+    float anchor_im;
+    samething_core_sincos(tones[tone].phase, &anchor_re, &anchor_im);
 
-  samething_core_field_add(ctx->header_data, &ctx->header_size,
-                           header->originator_code,
-                           SAMETHING_CORE_ORIGINATOR_CODE_LEN);
-  samething_core_field_add(ctx->header_data, &ctx->header_size,
-                           header->event_code, SAMETHING_CORE_EVENT_CODE_LEN);
+    // Lane k starts at the anchor rotated k times, and every lane advances by
+    // 4 samples per iteration.
+    const float32x4_t ar = vdupq_n_f32(anchor_re);
+    const float32x4_t ai = vdupq_n_f32(anchor_im);
+    const float32x4_t pr = vld1q_f32(step->re);
+    const float32x4_t pi = vld1q_f32(step->im);
 
-  for (size_t i = 0; i < SAMETHING_CORE_LOCATION_CODES_NUM_MAX; ++i) {
-    if (memcmp(header->location_codes[i],
-               SAMETHING_CORE_LOCATION_CODE_END_MARKER,
-               SAMETHING_CORE_LOCATION_CODE_LEN) == 0) {
-      break;
+    float32x4_t re = vsubq_f32(vmulq_f32(ar, pr), vmulq_f32(ai, pi));
+    float32x4_t im = vaddq_f32(vmulq_f32(ar, pi), vmulq_f32(ai, pr));
+
+    const float32x4_t sr = vdupq_n_f32(step->re[4]);
+    const float32x4_t si = vdupq_n_f32(step->im[4]);
+    const float32x4_t gain = vdupq_n_f32(tones[tone].gain);
+
+    for (size_t i = 0; i < num_samples; i += 4) {
+      vst1q_f32(&acc[i], vaddq_f32(vld1q_f32(&acc[i]), vmulq_f32(im, gain)));
+
+      const float32x4_t next_re =
+          vsubq_f32(vmulq_f32(re, sr), vmulq_f32(im, si));
+      im = vaddq_f32(vmulq_f32(re, si), vmulq_f32(im, sr));
+      re = next_re;
     }
-    samething_core_field_add(ctx->header_data, &ctx->header_size,
-                             header->location_codes[i],
-                             SAMETHING_CORE_LOCATION_CODE_LEN);
   }
-  ctx->header_data[ctx->header_size - 1] = '+';
 
-  samething_core_field_add(ctx->header_data, &ctx->header_size,
-                           header->valid_time_period,
-                           SAMETHING_CORE_VALID_TIME_PERIOD_LEN);
+  // Truncate to 32-bit integers like a scalar cast would, then narrow to 16
+  // bits; the narrowing saturates.
+  const float32x4_t scale = vdupq_n_f32(INT16_MAX);
+  _Alignas(16) int16_t out[SAMETHING_CORE_TONE_RENDER_MAX];
 
-  samething_core_field_add(ctx->header_data, &ctx->header_size,
-                           header->originator_time,
-                           SAMETHING_CORE_ORIGINATOR_TIME_LEN);
+  for (size_t i = 0; i < num_samples; i += 8) {
+    const int32x4_t lo = vcvtq_s32_f32(vmulq_f32(vld1q_f32(&acc[i]), scale));
+    const int32x4_t hi =
+        vcvtq_s32_f32(vmulq_f32(vld1q_f32(&acc[i + 4]), scale));
 
-  samething_core_field_add(ctx->header_data, &ctx->header_size,
-                           header->callsign, SAMETHING_CORE_CALLSIGN_LEN);
+    vst1q_s16(&out[i], vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+  }
+  memcpy(dst, out, num_samples * sizeof(int16_t));
+}
+#endif  // __ARM_NEON
+#else
+/// A quarter cycle of a sine wave in Q15, plus the peak.
+static const int16_t SAMETHING_CORE_SINE_TABLE[257] =
+    SAMETHING_CORE_SINE_TABLE_INIT;
 
-  // clang-format off
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_SECOND] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_THIRD] =
-  SAMETHING_CORE_AFSK_BITS_PER_CHAR * SAMETHING_CORE_AFSK_SAMPLES_PER_BIT *
-  (unsigned int)ctx->header_size;
-
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_AFSK_EOM_FIRST] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_AFSK_EOM_SECOND] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_AFSK_EOM_THIRD] =
-  SAMETHING_CORE_AFSK_BITS_PER_CHAR * SAMETHING_CORE_AFSK_SAMPLES_PER_BIT *
-  SAMETHING_CORE_EOM_HEADER_SIZE;
-
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_SILENCE_FIRST] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_SILENCE_SECOND] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_SILENCE_THIRD] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_SILENCE_FOURTH] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_SILENCE_FIFTH] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_SILENCE_SIXTH] =
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_SILENCE_SEVENTH] =
-  SAMETHING_CORE_SILENCE_DURATION * SAMETHING_CORE_SAMPLE_RATE;
-
-  ctx->seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL] =
-  header->attn_sig_duration * SAMETHING_CORE_SAMPLE_RATE;
-  // clang-format on
-}
-
-void samething_core_samples_gen(struct samething_core_gen_ctx *const ctx) {
-  SAMETHING_ASSERT(ctx != NULL);
+/// Computes the sine of a phase in Q15, interpolating between the entries of
+/// SAMETHING_CORE_SINE_TABLE.
+///
+/// The result is within 1.15 of the ideal value scaled to INT16_MAX.
+///
+/// @param phase The phase, where 2^32 is one full cycle.
+/// @returns The sine of the phase.
+static SAMETHING_ALWAYS_INLINE int32_t
+samething_core_sine_q15(const uint32_t phase) {
+  // The second and fourth quarters mirror the first and third. Mirroring by
+  // inverting the bits is off by 1/2^32 of a cycle, which is far below
+  // anything that can be represented in the output.
+  const uint32_t quarter =
+      ((phase & (UINT32_C(1) << 30)) ? ~phase : phase) & 0x3FFFFFFFU;
 
-  static const uint8_t
-      SAMETHING_CORE_EOM_HEADER[SAMETHING_CORE_EOM_HEADER_SIZE] = {
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          SAMETHING_CORE_PREAMBLE,
-          'N',
-          'N',
-          'N',
-          'N'};
+  const uint32_t index = quarter >> 22;
+  const int32_t frac = (int32_t)((quarter >> 7) & 0x7FFFU);
 
-  // Tried to generate a SAME header using a context for which a SAME header was
-  // already generated; bug.
-  SAMETHING_ASSERT(ctx->seq_state < SAMETHING_CORE_SEQ_STATE_NUM);
-
-  // Generate only SAMETHING_CORE_SAMPLES_NUM_MAX samples at a time.
-  for (unsigned int sample_count = 0;
-       sample_count < SAMETHING_CORE_SAMPLES_NUM_MAX; ++sample_count) {
-    switch (ctx->seq_state) {
-      case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST:
-      case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_SECOND:
-      case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_THIRD:
-        samething_core_afsk_gen(ctx, ctx->header_data, ctx->header_size,
-                                sample_count);
-        break;
+  const int32_t a = SAMETHING_CORE_SINE_TABLE[index];
+  const int32_t b = SAMETHING_CORE_SINE_TABLE[index + 1];
+  const int32_t sine = a + ((((b - a) * frac) + (1 << 14)) >> 15);
 
-      case SAMETHING_CORE_SEQ_STATE_SILENCE_FIRST:
-      case SAMETHING_CORE_SEQ_STATE_SILENCE_SECOND:
-      case SAMETHING_CORE_SEQ_STATE_SILENCE_THIRD:
-      case SAMETHING_CORE_SEQ_STATE_SILENCE_FOURTH:
-      case SAMETHING_CORE_SEQ_STATE_SILENCE_FIFTH:
-      case SAMETHING_CORE_SEQ_STATE_SILENCE_SIXTH:
-      case SAMETHING_CORE_SEQ_STATE_SILENCE_SEVENTH:
-        samething_core_silence_gen(ctx, sample_count);
-        break;
+  return (phase & (UINT32_C(1) << 31)) ? -sine : sine;
+}
 
-      case SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL:
-        samething_core_attn_sig_gen(ctx, sample_count);
-        break;
+SAMETHING_STATIC void samething_core_tone_render_scalar(
+    int16_t *const restrict dst, const size_t num_samples,
+    const struct samething_core_tone *const restrict tones,
+    const size_t num_tones) {
+  SAMETHING_ASSERT(dst != NULL);
+  SAMETHING_ASSERT(num_samples <= SAMETHING_CORE_TONE_RENDER_MAX);
+  SAMETHING_ASSERT(tones != NULL);
 
-      case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_FIRST:
-      case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_SECOND:
-      case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_THIRD:
-        samething_core_afsk_gen(ctx, SAMETHING_CORE_EOM_HEADER,
-                                SAMETHING_CORE_EOM_HEADER_SIZE, sample_count);
-        break;
+  // Each term keeps 7 fractional bits, which leaves room for many tones at
+  // full gain before the accumulator could overflow.
+  int32_t acc[SAMETHING_CORE_TONE_RENDER_MAX] = {0};
 
-      default:
-        SAMETHING_UNREACHABLE;
-        break;
+  for (size_t tone = 0; tone < num_tones; ++tone) {
+    SAMETHING_ASSERT(tones[tone].gain >= -SAMETHING_CORE_TONE_GAIN(2.0F));
+    SAMETHING_ASSERT(tones[tone].gain <= SAMETHING_CORE_TONE_GAIN(2.0F));
+
+    const uint32_t phase_inc = tones[tone].step->phase_inc;
+    const int32_t gain = tones[tone].gain;
+    uint32_t phase = tones[tone].phase;
+
+    for (size_t i = 0; i < num_samples; ++i) {
+      acc[i] += (samething_core_sine_q15(phase) * gain) >> 8;
+      phase += phase_inc;
     }
-    ctx->seq_samples_remaining[ctx->seq_state]--;
+  }
 
-    if (ctx->seq_samples_remaining[ctx->seq_state] == 0) {
-      ctx->seq_state++;
+  for (size_t i = 0; i < num_samples; ++i) {
+    const int32_t sample = (acc[i] + (1 << 6)) >> 7;
 
-      if (ctx->seq_state >= SAMETHING_CORE_SEQ_STATE_NUM) {
-        // We're done generating.
-        return;
-      }
+    if (sample > INT16_MAX) {
+      dst[i] = INT16_MAX;
+    } else if (sample < INT16_MIN) {
+      dst[i] = INT16_MIN;
+    } else {
+      dst[i] = (int16_t)sample;
+    }
+  }
+}
+#endif  // SAMETHING_CORE_FIXED_POINT
+
+/// Configures the rotation of an oscillator.
+///
+/// @param step The rotation to configure.
+/// @param phase_inc The per-sample phase increment of the oscillator, where
+///                  2^32 is one full cycle.
+static void samething_core_tone_step_init(
+    struct samething_core_tone_step *const step, const uint32_t phase_inc) {
+#ifdef SAMETHING_CORE_FIXED_POINT
+  step->phase_inc = phase_inc;
+#else
+  // Each power is computed directly rather than by repeated multiplication,
+  // so that none of them carry any accumulated rounding error.
+  for (uint32_t i = 0; i <= SAMETHING_CORE_TONE_LANES_MAX; ++i) {
+    samething_core_sincos(phase_inc * i, &step->re[i], &step->im[i]);
+  }
+#endif  // SAMETHING_CORE_FIXED_POINT
+}
+
+SAMETHING_STATIC samething_core_tone_kernel
+samething_core_tone_kernel_select(void) {
+#ifdef SAMETHING_CORE_FIXED_POINT
+  return samething_core_tone_render_scalar;
+#else
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+    return samething_core_tone_render_avx2;
+  }
+#endif  // defined(__x86_64__) || defined(__i386__)
+
+#if defined(__SSE2__)
+  return samething_core_tone_render_sse2;
+#elif defined(__ARM_NEON)
+  return samething_core_tone_render_neon;
+#else
+  return samething_core_tone_render_scalar;
+#endif
+#endif  // SAMETHING_CORE_FIXED_POINT
+}
+
+/// Renders a run of AFSK bits of the same value with the phase carried across
+/// them.
+///
+/// @param dst The buffer to render the samples to.
+/// @param bit The value of the bits to render (0 for space, 1 for mark).
+/// @param phase The phase of the first sample, where 2^32 is one full cycle.
+/// @param num_bits The number of bits to render.
+static void samething_core_afsk_tone_render(int16_t *const dst,
+                                            const unsigned int bit,
+                                            const uint32_t phase,
+                                            const size_t num_bits) {
+  for (size_t i = 0; i < num_bits; ++i) {
+    // Anchor every bit from the exact phase, so that the waveform of a bit
+    // doesn't depend on where in its run it falls.
+    const struct samething_core_tone tone = {
+        .step = &samething_core_afsk_steps[bit],
+        .phase = phase + (SAMETHING_CORE_AFSK_PHASE_INC[bit] *
+                          SAMETHING_CORE_AFSK_SAMPLES_PER_BIT * (uint32_t)i),
+        .gain = SAMETHING_CORE_TONE_GAIN(1.0F)};
+
+    samething_core_tone_render(&dst[i * SAMETHING_CORE_AFSK_SAMPLES_PER_BIT],
+                               SAMETHING_CORE_AFSK_SAMPLES_PER_BIT, &tone, 1);
+  }
+}
+
+/// Builds the shared waveform tables if they haven't been built already.
+///
+/// This is safe to call from multiple threads at once; threads which lose the
+/// race wait for the winner to finish building the tables. With
+/// SAMETHING_CORE_TINY, only the oscillators are set up, and there is no
+/// synchronization.
+static void samething_core_tables_init(void) {
+#ifdef SAMETHING_CORE_TINY
+  if (samething_core_tables_built) {
+    return;
+  }
+#else
+  if (atomic_load_explicit(&samething_core_tables_state,
+                           memory_order_acquire) ==
+      SAMETHING_CORE_TABLES_STATE_BUILT) {
+    return;
+  }
+
+  int expected = SAMETHING_CORE_TABLES_STATE_UNBUILT;
+
+  if (!atomic_compare_exchange_strong_explicit(
+          &samething_core_tables_state, &expected,
+          SAMETHING_CORE_TABLES_STATE_BUILDING, memory_order_acquire,
+          memory_order_acquire)) {
+    while (atomic_load_explicit(&samething_core_tables_state,
+                                memory_order_acquire) !=
+           SAMETHING_CORE_TABLES_STATE_BUILT) {
+      // Let the CPU know this is a spin-wait loop, which saves power and
+      // frees up the core for a sibling hardware thread.
+#if defined(__x86_64__) || defined(__i386__)
+      _mm_pause();
+#elif defined(__ARM_NEON)
+      __yield();
+#endif
+    }
+    return;
+  }
+#endif  // SAMETHING_CORE_TINY
+
+  samething_core_tone_render = samething_core_tone_kernel_select();
+
+  for (size_t bit = 0; bit < 2; ++bit) {
+    samething_core_tone_step_init(&samething_core_afsk_steps[bit],
+                                  SAMETHING_CORE_AFSK_PHASE_INC[bit]);
+
+#if !defined(SAMETHING_CORE_AFSK_CONTINUOUS_PHASE) && \
+    !defined(SAMETHING_CORE_TINY)
+    int16_t *const run = samething_core_afsk_run_table[bit];
+
+    samething_core_afsk_tone_render(run, (unsigned int)bit, 0, 1);
+
+    for (size_t pos = SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+         pos < SAMETHING_CORE_AFSK_RUN_SAMPLES_MAX;
+         pos += SAMETHING_CORE_AFSK_SAMPLES_PER_BIT) {
+      memcpy(&run[pos], run,
+             SAMETHING_CORE_AFSK_SAMPLES_PER_BIT * sizeof(int16_t));
+    }
+#endif
+  }
+
+  for (size_t rate = 0; rate < SAMETHING_CORE_SAMPLE_RATES_NUM; ++rate) {
+    const uint64_t sample_rate = SAMETHING_CORE_SAMPLE_RATES[rate];
+
+    for (size_t i = 0; i < 2; ++i) {
+      samething_core_tone_step_init(
+          &samething_core_rate_afsk_steps[rate][i],
+          (uint32_t)(((uint64_t)SAMETHING_CORE_AFSK_FREQ_NUM[i] << 32U) /
+                     (SAMETHING_CORE_AFSK_FREQ_DEN[i] * sample_rate)));
+      samething_core_tone_step_init(
+          &samething_core_rate_attn_sig_steps[rate][i],
+          (uint32_t)(((uint64_t)SAMETHING_CORE_ATTN_SIG_FREQS[i] << 32U) /
+                     sample_rate));
+    }
+    samething_core_tone_step_init(
+        &samething_core_rate_attn_sig_nwr_steps[rate],
+        (uint32_t)(((uint64_t)SAMETHING_CORE_ATTN_SIG_NWR_FREQ_HZ << 32U) /
+                   sample_rate));
+  }
+
+  // The NWR tone makes a whole cycle in a whole number of samples, so it is
+  // rendered once from phase 0 and repeated exactly.
+  struct samething_core_tone_step nwr_step;
+
+  samething_core_tone_step_init(
+      &nwr_step,
+      (uint32_t)(((uint64_t)SAMETHING_CORE_ATTN_SIG_NWR_FREQ_HZ << 32U) /
+                 SAMETHING_CORE_SAMPLE_RATE));
+
+  const struct samething_core_tone nwr_tone = {
+      .step = &nwr_step, .phase = 0, .gain = SAMETHING_CORE_TONE_GAIN(1.0F)};
+
+  samething_core_tone_render(samething_core_attn_sig_nwr_table,
+                             SAMETHING_CORE_ATTN_SIG_NWR_PERIOD, &nwr_tone, 1);
+
+  for (size_t pos = SAMETHING_CORE_ATTN_SIG_NWR_PERIOD;
+       pos < SAMETHING_CORE_ATTN_SIG_NWR_TABLE_SIZE;
+       pos += SAMETHING_CORE_ATTN_SIG_NWR_PERIOD) {
+    memcpy(&samething_core_attn_sig_nwr_table[pos],
+           samething_core_attn_sig_nwr_table,
+           SAMETHING_CORE_ATTN_SIG_NWR_PERIOD * sizeof(int16_t));
+  }
+
+#ifdef SAMETHING_CORE_TINY
+  samething_core_tables_built = true;
+#else
+  for (size_t i = 0; i < 2; ++i) {
+    samething_core_tone_step_init(
+        &samething_core_attn_sig_steps[i],
+        (uint32_t)(((uint64_t)SAMETHING_CORE_ATTN_SIG_FREQS[i] << 32U) /
+                   SAMETHING_CORE_SAMPLE_RATE));
+  }
+
+  for (size_t pos = 0; pos < SAMETHING_CORE_ATTN_SIG_PERIOD;
+       pos += SAMETHING_CORE_TONE_RENDER_MAX) {
+    size_t num_samples = SAMETHING_CORE_ATTN_SIG_PERIOD - pos;
+
+    if (num_samples > SAMETHING_CORE_TONE_RENDER_MAX) {
+      num_samples = SAMETHING_CORE_TONE_RENDER_MAX;
+    }
+
+    struct samething_core_tone tones[2];
+
+    for (size_t i = 0; i < 2; ++i) {
+      // Reduce the phase with integer arithmetic so that the table ends
+      // exactly where it begins, regardless of rounding.
+      const uint64_t cycles =
+          (SAMETHING_CORE_ATTN_SIG_FREQS[i] * pos) % SAMETHING_CORE_SAMPLE_RATE;
+
+      tones[i].step = &samething_core_attn_sig_steps[i];
+      tones[i].phase =
+          (uint32_t)((cycles << 32U) / SAMETHING_CORE_SAMPLE_RATE);
+      tones[i].gain = SAMETHING_CORE_TONE_GAIN(0.5F);
+    }
+    samething_core_tone_render(&samething_core_attn_sig_table[pos],
+                               num_samples, tones, 2);
+  }
+
+  // Every burst starts from phase 0, so the EOM burst comes out the same
+  // regardless of whether the phase is carried across bits.
+  uint32_t phase = 0;
+  size_t pos = 0;
+
+  for (size_t byte = 0; byte < SAMETHING_CORE_EOM_HEADER_SIZE; ++byte) {
+    for (unsigned int bit_pos = 0; bit_pos < SAMETHING_CORE_AFSK_BITS_PER_CHAR;
+         ++bit_pos) {
+      const unsigned int bit = (SAMETHING_CORE_EOM_HEADER[byte] >> bit_pos) & 1;
+
+      samething_core_afsk_tone_render(&samething_core_eom_table[pos], bit,
+                                      phase, 1);
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+      phase += SAMETHING_CORE_AFSK_PHASE_INC[bit] *
+               SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+      pos += SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
     }
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+    samething_core_eom_phases[byte + 1] = phase;
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
   }
+
+  atomic_store_explicit(&samething_core_tables_state,
+                        SAMETHING_CORE_TABLES_STATE_BUILT,
+                        memory_order_release);
+#endif  // SAMETHING_CORE_TINY
+}
+
+SAMETHING_STATIC void samething_core_field_add(uint8_t *const restrict data,
+                                               size_t *restrict data_size,
+                                               const char *restrict const field,
+                                               const size_t field_len) {
+  SAMETHING_ASSERT(data != NULL);
+  SAMETHING_ASSERT(data_size != NULL);
+  SAMETHING_ASSERT(field != NULL);
+  SAMETHING_ASSERT(field_len > 0);
+
+  // XXX: SAMETHING_CORE_CALLSIGN_LEN is the largest field, if this ever
+  // changes this must change as well.
+  SAMETHING_ASSERT(field_len <= SAMETHING_CORE_CALLSIGN_LEN);
+
+  memcpy(&data[*data_size], field, field_len);
+  *data_size += field_len;
+  data[(*data_size)++] = '-';
+}
+
+SAMETHING_STATIC size_t samething_core_afsk_plan_build(
+    uint8_t *const restrict plan, const uint8_t *const restrict data,
+    const size_t data_size) {
+  SAMETHING_ASSERT((plan != NULL) || (data_size == 0));
+  SAMETHING_ASSERT((data != NULL) || (data_size == 0));
+
+  size_t plan_size = 0;
+
+  for (size_t byte = 0; byte < data_size; ++byte) {
+    for (unsigned int bit_pos = 0; bit_pos < SAMETHING_CORE_AFSK_BITS_PER_CHAR;
+         ++bit_pos) {
+      const uint8_t symbol =
+          ((data[byte] >> bit_pos) & 1) ? SAMETHING_CORE_AFSK_RUN_MARK : 0;
+
+      // Extend the previous run if it's of the same bit and not yet full.
+      if ((plan_size > 0) &&
+          ((plan[plan_size - 1] & SAMETHING_CORE_AFSK_RUN_MARK) == symbol) &&
+          ((plan[plan_size - 1] & SAMETHING_CORE_AFSK_RUN_LEN_MASK) <
+           SAMETHING_CORE_AFSK_RUN_BITS_MAX)) {
+        plan[plan_size - 1]++;
+      } else {
+        plan[plan_size++] = symbol | 1U;
+      }
+    }
+  }
+  return plan_size;
+}
+
+#ifdef SAMETHING_CORE_TINY
+/// Renders part of a run of identical AFSK bits, each starting from phase 0,
+/// without a waveform table.
+///
+/// @param dst The buffer to render the samples to.
+/// @param bit The value of the bits to render (0 for space, 1 for mark).
+/// @param offset The first sample to render, counted from the start of the
+///               run.
+/// @param num_samples The number of samples to render.
+static void samething_core_afsk_run_copy(int16_t *const restrict dst,
+                                         const unsigned int bit, size_t offset,
+                                         const size_t num_samples) {
+  size_t generated = 0;
+
+  while (generated < num_samples) {
+    const size_t skip = offset % SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+    size_t run = SAMETHING_CORE_AFSK_SAMPLES_PER_BIT - skip;
+
+    if (run > num_samples - generated) {
+      run = num_samples - generated;
+    }
+
+    if (run == SAMETHING_CORE_AFSK_SAMPLES_PER_BIT) {
+      samething_core_afsk_tone_render(&dst[generated], bit, 0, 1);
+    } else {
+      // Only part of the bit is wanted; render all of it aside.
+      int16_t wave[SAMETHING_CORE_AFSK_SAMPLES_PER_BIT];
+
+      samething_core_afsk_tone_render(wave, bit, 0, 1);
+      memcpy(&dst[generated], &wave[skip], run * sizeof(int16_t));
+    }
+    generated += run;
+    offset += run;
+  }
+}
+
+/// Renders part of the End of Message (EOM) burst without a waveform table.
+///
+/// @param dst The buffer to render the samples to.
+/// @param pos The first sample to render, counted from the start of the burst.
+/// @param num_samples The number of samples to render.
+static void samething_core_eom_copy(int16_t *const restrict dst, size_t pos,
+                                    const size_t num_samples) {
+  size_t generated = 0;
+
+  while (generated < num_samples) {
+    const size_t bit_num = pos / SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+    const unsigned int bit =
+        (SAMETHING_CORE_EOM_HEADER[bit_num /
+                                   SAMETHING_CORE_AFSK_BITS_PER_CHAR] >>
+         (bit_num % SAMETHING_CORE_AFSK_BITS_PER_CHAR)) &
+        1U;
+
+    size_t run = SAMETHING_CORE_AFSK_SAMPLES_PER_BIT -
+                 (pos % SAMETHING_CORE_AFSK_SAMPLES_PER_BIT);
+
+    if (run > num_samples - generated) {
+      run = num_samples - generated;
+    }
+    samething_core_afsk_run_copy(&dst[generated], bit, pos, run);
+
+    generated += run;
+    pos += run;
+  }
+}
+#endif  // SAMETHING_CORE_TINY
+
+/// Renders an AFSK burst to an arbitrary buffer.
+///
+/// @param afsk The state of the burst.
+/// @param plan The bit plan of the part of the burst which follows the part
+///             covered by the ROM.
+/// @param plan_size The number of runs in the bit plan.
+/// @param rom_size The number of leading bytes of the burst which are the same
+///                 as those of the End of Message (EOM) burst.
+/// @param dst The buffer to render the samples to.
+/// @param num_samples The maximum number of samples to render.
+/// @returns The number of samples actually rendered.
+static size_t samething_core_afsk_render(
+    struct samething_core_afsk_state *const restrict afsk,
+    const uint8_t *const restrict plan, const size_t plan_size,
+    const size_t rom_size, int16_t *const restrict dst,
+    const size_t num_samples) {
+  SAMETHING_ASSERT((plan != NULL) || (plan_size == 0));
+  SAMETHING_ASSERT((plan_size > 0) || (rom_size > 0));
+  SAMETHING_ASSERT(rom_size <= SAMETHING_CORE_EOM_HEADER_SIZE);
+  SAMETHING_ASSERT(num_samples > 0);
+
+  size_t generated = 0;
+
+  const size_t rom_samples = rom_size * SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+                             SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+
+  if (afsk->rom_pos < rom_samples) {
+    // Stream the part of the burst covered by the ROM straight out of it.
+    generated = rom_samples - afsk->rom_pos;
+
+    if (generated > num_samples) {
+      generated = num_samples;
+    }
+
+#ifdef SAMETHING_CORE_TINY
+    samething_core_eom_copy(dst, afsk->rom_pos, generated);
+#else
+    memcpy(dst, &samething_core_eom_table[afsk->rom_pos],
+           generated * sizeof(int16_t));
+#endif  // SAMETHING_CORE_TINY
+
+    afsk->rom_pos += generated;
+
+    if (afsk->rom_pos < rom_samples) {
+      return generated;
+    }
+
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+    afsk->phase = samething_core_eom_phases[rom_size];
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  }
+
+  while ((generated < num_samples) && (afsk->run_pos < plan_size)) {
+    const uint8_t symbol = plan[afsk->run_pos];
+    const unsigned int bit = (symbol & SAMETHING_CORE_AFSK_RUN_MARK) ? 1 : 0;
+    const size_t run_samples =
+        (symbol & SAMETHING_CORE_AFSK_RUN_LEN_MASK) *
+        SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+
+    size_t run = run_samples - afsk->sample_num;
+
+    if (run > num_samples - generated) {
+      run = num_samples - generated;
+    }
+
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+    if (afsk->sample_num == 0) {
+      samething_core_afsk_tone_render(
+          afsk->run_wave, bit, afsk->phase,
+          symbol & SAMETHING_CORE_AFSK_RUN_LEN_MASK);
+    }
+    memcpy(&dst[generated], &afsk->run_wave[afsk->sample_num],
+           run * sizeof(int16_t));
+#elif defined(SAMETHING_CORE_TINY)
+    samething_core_afsk_run_copy(&dst[generated], bit, afsk->sample_num, run);
+#else
+    memcpy(&dst[generated],
+           &samething_core_afsk_run_table[bit][afsk->sample_num],
+           run * sizeof(int16_t));
+#endif
+
+    generated += run;
+    afsk->sample_num += (unsigned int)run;
+
+    if (afsk->sample_num < run_samples) {
+      return generated;
+    }
+
+    afsk->sample_num = 0;
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+    afsk->phase += SAMETHING_CORE_AFSK_PHASE_INC[bit] * (uint32_t)run_samples;
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+    afsk->run_pos++;
+  }
+
+  if (afsk->run_pos >= plan_size) {
+    // By the time we get here, we're completely done caring about the AFSK
+    // state for the current state; clear it to prepare for the next one.
+    memset(afsk, 0, sizeof(*afsk));
+  }
+  return generated;
+}
+
+#ifdef SAMETHING_TESTING
+// Generation goes through samething_core_afsk_render directly; this only
+// exposes it on a generation context for testing.
+SAMETHING_STATIC size_t samething_core_afsk_gen(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const uint8_t *const restrict plan, const size_t plan_size,
+    const size_t rom_size, int16_t *const restrict dst,
+    const size_t num_samples) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(dst != NULL);
+
+  return samething_core_afsk_render(&ctx->cursor.afsk, plan, plan_size,
+                                    rom_size, dst, num_samples);
+}
+#endif  // SAMETHING_TESTING
+
+SAMETHING_STATIC void samething_core_silence_gen(int16_t *const dst,
+                                                 const size_t num_samples) {
+  SAMETHING_ASSERT(dst != NULL);
+  memset(dst, 0, num_samples * sizeof(int16_t));
+}
+
+/// Looks up a sample rate within SAMETHING_CORE_SAMPLE_RATES.
+///
+/// @param sample_rate The sample rate to look up, in Hz.
+/// @returns The index of the sample rate, or SAMETHING_CORE_SAMPLE_RATES_NUM if
+///          it isn't supported.
+static size_t samething_core_sample_rate_index(const unsigned int sample_rate) {
+  size_t rate = 0;
+
+  while ((rate < SAMETHING_CORE_SAMPLE_RATES_NUM) &&
+         (SAMETHING_CORE_SAMPLE_RATES[rate] != sample_rate)) {
+    rate++;
+  }
+  return rate;
+}
+
+/// Computes the exact phase of a tone at a sample.
+///
+/// @param freq_num The numerator of the frequency of the tone, in Hz.
+/// @param freq_den The denominator of the frequency of the tone.
+/// @param sample_rate The sample rate, in Hz.
+/// @param sample_num The sample to compute the phase at, counted from where
+///                   the tone has a phase of 0.
+/// @returns The phase of the tone, where 2^32 is one full cycle.
+static uint32_t samething_core_tone_phase(const uint64_t freq_num,
+                                          const uint64_t freq_den,
+                                          const uint64_t sample_rate,
+                                          const uint64_t sample_num) {
+  const uint64_t period = freq_den * sample_rate;
+
+  return (uint32_t)((((sample_num * freq_num) % period) << 32U) / period);
+}
+
+/// Computes the first sample of a bit of an AFSK burst with an exact bit
+/// clock, which is the first one at or after its exact start time.
+///
+/// @param bit_num The bit within the burst.
+/// @param sample_rate The sample rate, in Hz.
+/// @returns The first sample of the bit, counted from the start of the burst.
+static size_t samething_core_afsk_bit_start(const size_t bit_num,
+                                            const unsigned int sample_rate) {
+  const uint64_t time = (uint64_t)bit_num * SAMETHING_CORE_AFSK_BIT_RATE_DEN *
+                        sample_rate;
+
+  return (size_t)((time + SAMETHING_CORE_AFSK_BIT_RATE_NUM - 1U) /
+                  SAMETHING_CORE_AFSK_BIT_RATE_NUM);
+}
+
+/// Extracts a bit of data, in the order bits are transmitted.
+///
+/// @param data The data to extract the bit from.
+/// @param bit_num The bit to extract.
+/// @returns The value of the bit (0 for space, 1 for mark).
+static SAMETHING_ALWAYS_INLINE unsigned int samething_core_data_bit(
+    const uint8_t *const data, const size_t bit_num) {
+  return (data[bit_num / SAMETHING_CORE_AFSK_BITS_PER_CHAR] >>
+          (bit_num % SAMETHING_CORE_AFSK_BITS_PER_CHAR)) &
+         1U;
+}
+
+/// Renders an AFSK burst with an exact bit clock to an arbitrary buffer.
+///
+/// Every bit lasts a whole number of cycles of its tone, so the phase of the
+/// oscillator at any sample follows from its position within the burst alone.
+/// This makes the phase continuous across bits either way.
+///
+/// Each bit is rendered from the exact phase at its first sample, so that the
+/// samples don't depend on how the burst is split up between calls.
+///
+/// @param afsk The state of the burst.
+/// @param data The data to generate the burst from.
+/// @param data_size The size of the data to generate the burst from.
+/// @param rate The index of the sample rate within SAMETHING_CORE_SAMPLE_RATES.
+/// @param dst The buffer to render the samples to.
+/// @param num_samples The maximum number of samples to render.
+/// @returns The number of samples actually rendered.
+static size_t samething_core_afsk_exact_render(
+    struct samething_core_afsk_state *const restrict afsk,
+    const uint8_t *const restrict data, const size_t data_size,
+    const size_t rate, int16_t *const restrict dst, const size_t num_samples) {
+  SAMETHING_ASSERT(data != NULL);
+  SAMETHING_ASSERT(rate < SAMETHING_CORE_SAMPLE_RATES_NUM);
+
+  const unsigned int sample_rate = SAMETHING_CORE_SAMPLE_RATES[rate];
+  const size_t burst_samples = samething_core_afsk_bit_start(
+      data_size * SAMETHING_CORE_AFSK_BITS_PER_CHAR, sample_rate);
+
+  size_t generated = 0;
+
+  while ((generated < num_samples) && (afsk->burst_pos < burst_samples)) {
+    const size_t bit_num = (size_t)(
+        ((uint64_t)afsk->burst_pos * SAMETHING_CORE_AFSK_BIT_RATE_NUM) /
+        ((uint64_t)SAMETHING_CORE_AFSK_BIT_RATE_DEN * sample_rate));
+    const unsigned int bit = samething_core_data_bit(data, bit_num);
+    const size_t bit_start =
+        samething_core_afsk_bit_start(bit_num, sample_rate);
+    const size_t bit_samples =
+        samething_core_afsk_bit_start(bit_num + 1, sample_rate) - bit_start;
+    const size_t skip = afsk->burst_pos - bit_start;
+
+    // Bits are at most 93 samples long at SAMETHING_CORE_SAMPLE_RATE_MAX.
+    SAMETHING_ASSERT(bit_samples <= SAMETHING_CORE_TONE_RENDER_MAX);
+
+    size_t run = bit_samples - skip;
+
+    if (run > num_samples - generated) {
+      run = num_samples - generated;
+    }
+
+    const struct samething_core_tone tone = {
+        .step = &samething_core_rate_afsk_steps[rate][bit],
+        .phase = samething_core_tone_phase(SAMETHING_CORE_AFSK_FREQ_NUM[bit],
+                                           SAMETHING_CORE_AFSK_FREQ_DEN[bit],
+                                           sample_rate, bit_start),
+        .gain = SAMETHING_CORE_TONE_GAIN(1.0F)};
+
+    if ((skip == 0) && (run == bit_samples)) {
+      samething_core_tone_render(&dst[generated], bit_samples, &tone, 1);
+    } else {
+      // Only part of the bit is wanted; render all of it aside.
+      int16_t wave[SAMETHING_CORE_TONE_RENDER_MAX];
+
+      samething_core_tone_render(wave, bit_samples, &tone, 1);
+      memcpy(&dst[generated], &wave[skip], run * sizeof(int16_t));
+    }
+    generated += run;
+    afsk->burst_pos += run;
+  }
+
+  if (afsk->burst_pos >= burst_samples) {
+    memset(afsk, 0, sizeof(*afsk));
+  }
+  return generated;
+}
+
+/// Renders the attention signal at any of SAMETHING_CORE_SAMPLE_RATES to an
+/// arbitrary buffer.
+///
+/// The oscillators are anchored to their exact phases every
+/// SAMETHING_CORE_TONE_RENDER_MAX samples from the start of the period, so
+/// that the samples don't depend on how the signal is split up between calls.
+///
+/// @param sample_num The current sample within the period of the attention
+///                   signal, which is one second long.
+/// @param type Which attention signal to render.
+/// @param rate The index of the sample rate within SAMETHING_CORE_SAMPLE_RATES.
+/// @param dst The buffer to render the samples to.
+/// @param num_samples The number of samples to render.
+static void samething_core_attn_sig_exact_render(
+    unsigned int *const restrict sample_num,
+    const enum samething_core_attn_sig_type type, const size_t rate,
+    int16_t *const restrict dst, const size_t num_samples) {
+  SAMETHING_ASSERT(rate < SAMETHING_CORE_SAMPLE_RATES_NUM);
+
+  const unsigned int sample_rate = SAMETHING_CORE_SAMPLE_RATES[rate];
+
+  size_t generated = 0;
+
+  while (generated < num_samples) {
+    const unsigned int anchor =
+        *sample_num - (*sample_num % SAMETHING_CORE_TONE_RENDER_MAX);
+    const size_t skip = *sample_num - anchor;
+    const size_t block_samples =
+        ((sample_rate - anchor) < SAMETHING_CORE_TONE_RENDER_MAX)
+            ? (sample_rate - anchor)
+            : SAMETHING_CORE_TONE_RENDER_MAX;
+
+    size_t run = block_samples - skip;
+
+    if (run > num_samples - generated) {
+      run = num_samples - generated;
+    }
+
+    struct samething_core_tone tones[2];
+    size_t num_tones = 2;
+
+    if (type == SAMETHING_CORE_ATTN_SIG_TYPE_NWR) {
+      tones[0].step = &samething_core_rate_attn_sig_nwr_steps[rate];
+      tones[0].phase = samething_core_tone_phase(
+          SAMETHING_CORE_ATTN_SIG_NWR_FREQ_HZ, 1, sample_rate, anchor);
+      tones[0].gain = SAMETHING_CORE_TONE_GAIN(1.0F);
+      num_tones = 1;
+    } else {
+      for (size_t i = 0; i < 2; ++i) {
+        tones[i].step = &samething_core_rate_attn_sig_steps[rate][i];
+        tones[i].phase = samething_core_tone_phase(
+            SAMETHING_CORE_ATTN_SIG_FREQS[i], 1, sample_rate, anchor);
+        tones[i].gain = SAMETHING_CORE_TONE_GAIN(0.5F);
+      }
+    }
+
+    if ((skip == 0) && (run == block_samples)) {
+      samething_core_tone_render(&dst[generated], block_samples, tones,
+                                 num_tones);
+    } else {
+      int16_t wave[SAMETHING_CORE_TONE_RENDER_MAX];
+
+      samething_core_tone_render(wave, block_samples, tones, num_tones);
+      memcpy(&dst[generated], &wave[skip], run * sizeof(int16_t));
+    }
+    generated += run;
+    *sample_num += (unsigned int)run;
+
+    if (*sample_num >= sample_rate) {
+      *sample_num = 0;
+    }
+  }
+}
+
+/// Renders the attention signal to an arbitrary buffer.
+///
+/// @param sample_num The current sample within the period of the attention
+///                   signal.
+/// @param type Which attention signal to render.
+/// @param dst The buffer to render the samples to.
+/// @param num_samples The number of samples to render.
+static void samething_core_attn_sig_render(
+    unsigned int *const restrict sample_num,
+    const enum samething_core_attn_sig_type type, int16_t *const restrict dst,
+    const size_t num_samples) {
+  SAMETHING_ASSERT(num_samples > 0);
+
+#ifdef SAMETHING_CORE_TINY
+  if (type != SAMETHING_CORE_ATTN_SIG_TYPE_NWR) {
+    // The table is anchored the same way as the exact attention signal, so
+    // rendering it directly gives the same samples.
+    samething_core_attn_sig_exact_render(
+        sample_num, type,
+        samething_core_sample_rate_index(SAMETHING_CORE_SAMPLE_RATE), dst,
+        num_samples);
+    return;
+  }
+
+  const int16_t *const table = samething_core_attn_sig_nwr_table;
+  const size_t table_size = SAMETHING_CORE_ATTN_SIG_NWR_TABLE_SIZE;
+#else
+  const int16_t *table = samething_core_attn_sig_table;
+  size_t table_size = SAMETHING_CORE_ATTN_SIG_PERIOD;
+
+  if (type == SAMETHING_CORE_ATTN_SIG_TYPE_NWR) {
+    table = samething_core_attn_sig_nwr_table;
+    table_size = SAMETHING_CORE_ATTN_SIG_NWR_TABLE_SIZE;
+  }
+#endif  // SAMETHING_CORE_TINY
+
+  // The table repeats a whole number of times within each period.
+  size_t generated = 0;
+
+  while (generated < num_samples) {
+    const size_t pos = *sample_num % table_size;
+    size_t run = table_size - pos;
+
+    if (run > num_samples - generated) {
+      run = num_samples - generated;
+    }
+
+    memcpy(&dst[generated], &table[pos], run * sizeof(int16_t));
+
+    generated += run;
+    *sample_num += (unsigned int)run;
+
+    if (*sample_num >= SAMETHING_CORE_ATTN_SIG_PERIOD) {
+      *sample_num = 0;
+    }
+  }
+}
+
+#ifdef SAMETHING_TESTING
+// Likewise for samething_core_attn_sig_render.
+SAMETHING_STATIC void samething_core_attn_sig_gen(
+    struct samething_core_gen_ctx *const restrict ctx,
+    int16_t *const restrict dst, const size_t num_samples) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(dst != NULL);
+
+  samething_core_attn_sig_render(&ctx->cursor.attn_sig_sample_num,
+                                 ctx->attn_sig_type, dst, num_samples);
+}
+#endif  // SAMETHING_TESTING
+
+/// The standard sequence plan, which every message followed before sequence
+/// plans could be chosen. The index of each step is its sequence state.
+static const struct samething_core_seq_step
+    SAMETHING_CORE_SEQ_PLAN_STANDARD[SAMETHING_CORE_SEQ_STATE_NUM] = {
+        {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+        {SAMETHING_CORE_SEQ_KIND_SILENCE,
+         SAMETHING_CORE_SILENCE_DURATION * 1000U},
+        {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+        {SAMETHING_CORE_SEQ_KIND_SILENCE,
+         SAMETHING_CORE_SILENCE_DURATION * 1000U},
+        {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+        {SAMETHING_CORE_SEQ_KIND_SILENCE,
+         SAMETHING_CORE_SILENCE_DURATION * 1000U},
+        {SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL, 0},
+        {SAMETHING_CORE_SEQ_KIND_SILENCE,
+         SAMETHING_CORE_SILENCE_DURATION * 1000U},
+        {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+        {SAMETHING_CORE_SEQ_KIND_SILENCE,
+         SAMETHING_CORE_SILENCE_DURATION * 1000U},
+        {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+        {SAMETHING_CORE_SEQ_KIND_SILENCE,
+         SAMETHING_CORE_SILENCE_DURATION * 1000U},
+        {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+        {SAMETHING_CORE_SEQ_KIND_SILENCE,
+         SAMETHING_CORE_SILENCE_DURATION * 1000U}};
+
+/// Computes the total number of samples in a step of a sequence plan which
+/// isn't silence; that depends only on what the step generates.
+///
+/// @param ctx The generation context holding the message.
+/// @param kind What the step generates.
+/// @returns The number of samples in the step.
+static size_t samething_core_seq_kind_samples_num(
+    const struct samething_core_gen_ctx *const ctx,
+    const enum samething_core_seq_kind kind) {
+  switch (kind) {
+    case SAMETHING_CORE_SEQ_KIND_AFSK_HEADER:
+      if (ctx->sample_rate != 0) {
+        return samething_core_afsk_bit_start(
+            ctx->header_size * SAMETHING_CORE_AFSK_BITS_PER_CHAR,
+            ctx->sample_rate);
+      }
+      return SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+             SAMETHING_CORE_AFSK_SAMPLES_PER_BIT * ctx->header_size;
+
+    case SAMETHING_CORE_SEQ_KIND_AFSK_EOM:
+      if (ctx->sample_rate != 0) {
+        return samething_core_afsk_bit_start(
+            SAMETHING_CORE_EOM_HEADER_SIZE * SAMETHING_CORE_AFSK_BITS_PER_CHAR,
+            ctx->sample_rate);
+      }
+      return SAMETHING_CORE_EOM_SAMPLES_NUM;
+
+    case SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL:
+      return ctx->attn_sig_samples_num;
+
+    default:
+      SAMETHING_UNREACHABLE;
+      return 0;
+  }
+}
+
+/// Brings the number of samples in every step of the sequence plan of a
+/// generation context which isn't silence up to date with its header.
+///
+/// @param ctx The generation context.
+static void samething_core_seq_plan_refresh(
+    struct samething_core_gen_ctx *const ctx) {
+  for (size_t step = 0; step < ctx->seq_plan_size; ++step) {
+    struct samething_core_seq_entry *const entry = &ctx->seq_plan[step];
+
+    if (entry->kind != SAMETHING_CORE_SEQ_KIND_SILENCE) {
+      entry->num_samples =
+          (uint32_t)samething_core_seq_kind_samples_num(ctx, entry->kind);
+    }
+  }
+}
+
+/// Expands a sequence plan into the number of samples of each step, for a
+/// generation context whose header and sample rate are already set up.
+///
+/// @param ctx The generation context.
+/// @param steps The steps of the sequence plan, in order.
+/// @param num_steps The number of steps.
+static void samething_core_seq_plan_build(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const struct samething_core_seq_step *const restrict steps,
+    const size_t num_steps) {
+  SAMETHING_ASSERT(steps != NULL);
+  SAMETHING_ASSERT((num_steps > 0) &&
+                   (num_steps <= SAMETHING_CORE_SEQ_PLAN_SIZE_MAX));
+
+#ifndef NDEBUG
+  // No plan may make for a longer message than the standard one can be.
+  size_t kinds_num[SAMETHING_CORE_SEQ_KIND_SILENCE + 1] = {0};
+  uint64_t silence_ms = 0;
+
+  for (size_t step = 0; step < num_steps; ++step) {
+    SAMETHING_ASSERT(steps[step].kind <= SAMETHING_CORE_SEQ_KIND_SILENCE);
+
+    kinds_num[steps[step].kind]++;
+
+    if (steps[step].kind == SAMETHING_CORE_SEQ_KIND_SILENCE) {
+      silence_ms += steps[step].duration_ms;
+    }
+  }
+
+  SAMETHING_ASSERT(kinds_num[SAMETHING_CORE_SEQ_KIND_AFSK_HEADER] <=
+                   SAMETHING_CORE_SEQ_BURSTS_NUM_MAX);
+  SAMETHING_ASSERT(kinds_num[SAMETHING_CORE_SEQ_KIND_AFSK_EOM] <=
+                   SAMETHING_CORE_SEQ_BURSTS_NUM_MAX);
+  SAMETHING_ASSERT(kinds_num[SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL] <= 1);
+  SAMETHING_ASSERT(silence_ms <= SAMETHING_CORE_SEQ_SILENCE_MS_MAX);
+#endif  // NDEBUG
+
+  const uint64_t sample_rate =
+      (ctx->sample_rate != 0) ? ctx->sample_rate : SAMETHING_CORE_SAMPLE_RATE;
+
+  for (size_t step = 0; step < num_steps; ++step) {
+    struct samething_core_seq_entry *const entry = &ctx->seq_plan[step];
+
+    entry->kind = steps[step].kind;
+    entry->num_samples =
+        (entry->kind == SAMETHING_CORE_SEQ_KIND_SILENCE)
+            ? (uint32_t)((steps[step].duration_ms * sample_rate) / 1000U)
+            : 0;
+  }
+
+  ctx->seq_plan_size = num_steps;
+  samething_core_seq_plan_refresh(ctx);
+}
+
+/// Builds the header data of a generation context, and its bit plan.
+///
+/// @param ctx The generation context.
+/// @param header The header data to generate a SAME header from.
+static void samething_core_header_build(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const struct samething_core_header *const restrict header) {
+  static const uint8_t SAMETHING_CORE_INITIAL_HEADER[] = {
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      SAMETHING_CORE_PREAMBLE,
+      'Z',
+      'C',
+      'Z',
+      'C',
+      '-',
+      'O',
+      'R',
+      'G',
+      '-',
+      'E',
+      'E',
+      'E',
+      '-',
+      'P',
+      'S',
+      'S',
+      'C',
+      'C',
+      'C'};
+
+  memcpy(&ctx->header_data, SAMETHING_CORE_INITIAL_HEADER,
+         sizeof(SAMETHING_CORE_INITIAL_HEADER));
+
+  // We want to start populating the fields after the first dash.
+  ctx->header_size =
+      SAMETHING_CORE_PREAMBLE_NUM + SAMETHING_CORE_ASCII_ID_LEN + 1;
+
+  samething_core_field_add(ctx->header_data, &ctx->header_size,
+                           header->originator_code,
+                           SAMETHING_CORE_ORIGINATOR_CODE_LEN);
+  samething_core_field_add(ctx->header_data, &ctx->header_size,
+                           header->event_code, SAMETHING_CORE_EVENT_CODE_LEN);
+
+  for (size_t i = 0; i < SAMETHING_CORE_LOCATION_CODES_NUM_MAX; ++i) {
+    if (memcmp(header->location_codes[i],
+               SAMETHING_CORE_LOCATION_CODE_END_MARKER,
+               SAMETHING_CORE_LOCATION_CODE_LEN) == 0) {
+      break;
+    }
+    samething_core_field_add(ctx->header_data, &ctx->header_size,
+                             header->location_codes[i],
+                             SAMETHING_CORE_LOCATION_CODE_LEN);
+  }
+  ctx->header_data[ctx->header_size - 1] = '+';
+
+  samething_core_field_add(ctx->header_data, &ctx->header_size,
+                           header->valid_time_period,
+                           SAMETHING_CORE_VALID_TIME_PERIOD_LEN);
+
+  samething_core_field_add(ctx->header_data, &ctx->header_size,
+                           header->originator_time,
+                           SAMETHING_CORE_ORIGINATOR_TIME_LEN);
+
+  samething_core_field_add(ctx->header_data, &ctx->header_size,
+                           header->callsign, SAMETHING_CORE_CALLSIGN_LEN);
+
+  // The preamble is streamed out of the ROM, so only what follows it needs a
+  // bit plan.
+  ctx->header_plan_size = samething_core_afsk_plan_build(
+      ctx->header_plan, &ctx->header_data[SAMETHING_CORE_PREAMBLE_NUM],
+      ctx->header_size - SAMETHING_CORE_PREAMBLE_NUM);
+}
+
+/// Configures a generation context to generate the specified header.
+///
+/// @param ctx The generation context.
+/// @param header The header data to generate a SAME header from.
+/// @param sample_rate The sample rate to generate at, or 0 to generate at
+///                    SAMETHING_CORE_SAMPLE_RATE with
+///                    SAMETHING_CORE_AFSK_SAMPLES_PER_BIT samples per bit.
+/// @param steps The steps of the sequence plan, in order.
+/// @param num_steps The number of steps.
+static void samething_core_ctx_setup(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const struct samething_core_header *const restrict header,
+    const unsigned int sample_rate,
+    const struct samething_core_seq_step *const restrict steps,
+    const size_t num_steps) {
+  SAMETHING_ASSERT(header->attn_sig_type < SAMETHING_CORE_ATTN_SIG_TYPE_NUM);
+
+  samething_core_tables_init();
+  samething_core_header_build(ctx, header);
+
+  ctx->sample_rate = sample_rate;
+  ctx->sample_rate_index = (unsigned int)samething_core_sample_rate_index(
+      (sample_rate != 0) ? sample_rate : SAMETHING_CORE_SAMPLE_RATE);
+  ctx->attn_sig_samples_num =
+      header->attn_sig_duration *
+      ((sample_rate != 0) ? sample_rate : SAMETHING_CORE_SAMPLE_RATE);
+  ctx->attn_sig_type = header->attn_sig_type;
+
+  samething_core_seq_plan_build(ctx, steps, num_steps);
+
+  // Only the state is reset; it is the one part of a generation context which
+  // changes, and anything else left over from a previous message is unused.
+  samething_core_cursor_seek(ctx, &ctx->cursor, 0);
+}
+
+void samething_core_ctx_init(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const struct samething_core_header *const restrict header) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(header != NULL);
+
+  samething_core_ctx_setup(ctx, header, 0, SAMETHING_CORE_SEQ_PLAN_STANDARD,
+                           SAMETHING_CORE_SEQ_STATE_NUM);
+}
+
+void samething_core_ctx_rate_init(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const struct samething_core_header *const restrict header,
+    const unsigned int sample_rate) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(header != NULL);
+  SAMETHING_ASSERT(samething_core_sample_rate_index(sample_rate) <
+                   SAMETHING_CORE_SAMPLE_RATES_NUM);
+
+  samething_core_ctx_setup(ctx, header, sample_rate,
+                           SAMETHING_CORE_SEQ_PLAN_STANDARD,
+                           SAMETHING_CORE_SEQ_STATE_NUM);
+}
+
+void samething_core_ctx_plan_init(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const struct samething_core_header *const restrict header,
+    const unsigned int sample_rate,
+    const struct samething_core_seq_step *const restrict steps,
+    const size_t num_steps) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(header != NULL);
+  SAMETHING_ASSERT((sample_rate == 0) ||
+                   (samething_core_sample_rate_index(sample_rate) <
+                    SAMETHING_CORE_SAMPLE_RATES_NUM));
+
+  samething_core_ctx_setup(ctx, header, sample_rate, steps, num_steps);
+}
+
+/// Rewrites the bytes of a field within header data which differ from the
+/// field specified, and widens the range of changed bytes to cover them.
+///
+/// @param data The header data holding the field.
+/// @param pos The offset of the field within the header data.
+/// @param field The new value of the field.
+/// @param field_len The length of the field.
+/// @param first The first byte which changed, which is moved back if needed.
+/// @param end The byte after the last one which changed, which is moved
+///            forward if needed.
+static void samething_core_field_patch(uint8_t *const restrict data,
+                                       const size_t pos,
+                                       const char *restrict const field,
+                                       const size_t field_len,
+                                       size_t *const restrict first,
+                                       size_t *const restrict end) {
+  for (size_t i = 0; i < field_len; ++i) {
+    if (data[pos + i] != (uint8_t)field[i]) {
+      data[pos + i] = (uint8_t)field[i];
+
+      if (pos + i < *first) {
+        *first = pos + i;
+      }
+      *end = pos + i + 1;
+    }
+  }
+}
+
+/// Rewrites the fields of the header data of a generation context which differ
+/// from those of a header with the same number of location codes.
+///
+/// @param ctx The generation context.
+/// @param header The header to take the fields from.
+/// @param num_codes The number of location codes in both headers.
+/// @param first Where to store the first byte which changed.
+/// @param end Where to store the byte after the last one which changed, which
+///            is no further than first if nothing did.
+static void samething_core_header_patch(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const struct samething_core_header *const restrict header,
+    const size_t num_codes, size_t *const restrict first,
+    size_t *const restrict end) {
+  *first = ctx->header_size;
+  *end = 0;
+
+  size_t pos = SAMETHING_CORE_PREAMBLE_NUM + SAMETHING_CORE_ASCII_ID_LEN + 1;
+
+  samething_core_field_patch(ctx->header_data, pos, header->originator_code,
+                             SAMETHING_CORE_ORIGINATOR_CODE_LEN, first, end);
+  pos += SAMETHING_CORE_ORIGINATOR_CODE_LEN + 1;
+
+  samething_core_field_patch(ctx->header_data, pos, header->event_code,
+                             SAMETHING_CORE_EVENT_CODE_LEN, first, end);
+  pos += SAMETHING_CORE_EVENT_CODE_LEN + 1;
+
+  for (size_t i = 0; i < num_codes; ++i) {
+    samething_core_field_patch(ctx->header_data, pos, header->location_codes[i],
+                               SAMETHING_CORE_LOCATION_CODE_LEN, first, end);
+    pos += SAMETHING_CORE_LOCATION_CODE_LEN + 1;
+  }
+
+  samething_core_field_patch(ctx->header_data, pos, header->valid_time_period,
+                             SAMETHING_CORE_VALID_TIME_PERIOD_LEN, first, end);
+  pos += SAMETHING_CORE_VALID_TIME_PERIOD_LEN + 1;
+
+  samething_core_field_patch(ctx->header_data, pos, header->originator_time,
+                             SAMETHING_CORE_ORIGINATOR_TIME_LEN, first, end);
+  pos += SAMETHING_CORE_ORIGINATOR_TIME_LEN + 1;
+
+  samething_core_field_patch(ctx->header_data, pos, header->callsign,
+                             SAMETHING_CORE_CALLSIGN_LEN, first, end);
+
+  if (*first < *end) {
+    // Runs may merge or split across the bytes which changed, so the bit plan
+    // is rebuilt; this costs next to nothing next to rendering the burst.
+    ctx->header_plan_size = samething_core_afsk_plan_build(
+        ctx->header_plan, &ctx->header_data[SAMETHING_CORE_PREAMBLE_NUM],
+        ctx->header_size - SAMETHING_CORE_PREAMBLE_NUM);
+  }
+}
+
+bool samething_core_header_update(
+    struct samething_core_gen_ctx *const restrict ctx,
+    const struct samething_core_header *const restrict header,
+    struct samething_core_seq_span *const restrict changed) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(header != NULL);
+  SAMETHING_ASSERT(header->attn_sig_type < SAMETHING_CORE_ATTN_SIG_TYPE_NUM);
+  SAMETHING_ASSERT(changed != NULL);
+
+  // Every field is followed by a dash (or a plus), so the fields sit at fixed
+  // offsets on either side of the location codes.
+  const size_t codes_pos = SAMETHING_CORE_PREAMBLE_NUM +
+                           SAMETHING_CORE_ASCII_ID_LEN + 1 +
+                           SAMETHING_CORE_ORIGINATOR_CODE_LEN + 1 +
+                           SAMETHING_CORE_EVENT_CODE_LEN + 1;
+  const size_t tail_size = SAMETHING_CORE_VALID_TIME_PERIOD_LEN + 1 +
+                           SAMETHING_CORE_ORIGINATOR_TIME_LEN + 1 +
+                           SAMETHING_CORE_CALLSIGN_LEN + 1;
+
+  SAMETHING_ASSERT(ctx->header_size >= codes_pos + tail_size);
+
+  const size_t num_codes = (ctx->header_size - codes_pos - tail_size) /
+                           (SAMETHING_CORE_LOCATION_CODE_LEN + 1);
+
+  // The number of location codes is unchanged only if the end marker is
+  // right where it was before, and nowhere earlier.
+  bool in_place =
+      (num_codes == SAMETHING_CORE_LOCATION_CODES_NUM_MAX) ||
+      (memcmp(header->location_codes[num_codes],
+              SAMETHING_CORE_LOCATION_CODE_END_MARKER,
+              SAMETHING_CORE_LOCATION_CODE_LEN) == 0);
+
+  for (size_t i = 0; in_place && (i < num_codes); ++i) {
+    in_place = memcmp(header->location_codes[i],
+                      SAMETHING_CORE_LOCATION_CODE_END_MARKER,
+                      SAMETHING_CORE_LOCATION_CODE_LEN) != 0;
+  }
+
+  size_t first = 0;
+  size_t end = 0;
+
+  if (in_place) {
+    samething_core_header_patch(ctx, header, num_codes, &first, &end);
+  } else {
+    samething_core_header_build(ctx, header);
+  }
+
+  ctx->attn_sig_samples_num =
+      header->attn_sig_duration * ((ctx->sample_rate != 0)
+                                       ? ctx->sample_rate
+                                       : SAMETHING_CORE_SAMPLE_RATE);
+  ctx->attn_sig_type = header->attn_sig_type;
+
+  samething_core_seq_plan_refresh(ctx);
+  samething_core_cursor_seek(ctx, &ctx->cursor, 0);
+
+  if (!in_place) {
+    changed->start = 0;
+    changed->num_samples = samething_core_seq_kind_samples_num(
+        ctx, SAMETHING_CORE_SEQ_KIND_AFSK_HEADER);
+    return false;
+  }
+
+  if (first >= end) {
+    changed->start = 0;
+    changed->num_samples = 0;
+    return true;
+  }
+
+  if (ctx->sample_rate != 0) {
+    // The phase at any sample follows from its position alone.
+    changed->start = samething_core_afsk_bit_start(
+        first * SAMETHING_CORE_AFSK_BITS_PER_CHAR, ctx->sample_rate);
+    end = samething_core_afsk_bit_start(end * SAMETHING_CORE_AFSK_BITS_PER_CHAR,
+                                        ctx->sample_rate);
+  } else {
+    changed->start = first * SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+                     SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+    // The phase of every later bit depends on the bits which changed.
+    end = samething_core_seq_kind_samples_num(
+        ctx, SAMETHING_CORE_SEQ_KIND_AFSK_HEADER);
+#else
+    end = end * SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+          SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  }
+
+  SAMETHING_ASSERT(end <= samething_core_seq_kind_samples_num(
+                              ctx, SAMETHING_CORE_SEQ_KIND_AFSK_HEADER));
+
+  changed->num_samples = end - changed->start;
+  return true;
+}
+
+/// Renders part of a step of the sequence plan of a message.
+///
+/// @param ctx The generation context holding the message.
+/// @param kind What the step generates.
+/// @param afsk The state of the AFSK burst being rendered, if any.
+/// @param attn_sig_sample_num The current sample within the period of the
+///                            attention signal.
+/// @param dst The buffer to render the samples to.
+/// @param num_samples The number of samples to render, which must not exceed
+///                    what remains of the step.
+/// @returns The number of samples actually rendered.
+static size_t samething_core_seq_state_render(
+    const struct samething_core_gen_ctx *const restrict ctx,
+    const enum samething_core_seq_kind kind,
+    struct samething_core_afsk_state *const restrict afsk,
+    unsigned int *const restrict attn_sig_sample_num,
+    int16_t *const restrict dst, const size_t num_samples) {
+  if (ctx->sample_rate != 0) {
+    const size_t rate = ctx->sample_rate_index;
+
+    switch (kind) {
+      case SAMETHING_CORE_SEQ_KIND_AFSK_HEADER:
+        return samething_core_afsk_exact_render(afsk, ctx->header_data,
+                                                ctx->header_size, rate, dst,
+                                                num_samples);
+
+      case SAMETHING_CORE_SEQ_KIND_AFSK_EOM:
+        return samething_core_afsk_exact_render(
+            afsk, SAMETHING_CORE_EOM_HEADER, SAMETHING_CORE_EOM_HEADER_SIZE,
+            rate, dst, num_samples);
+
+      case SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL:
+        samething_core_attn_sig_exact_render(
+            attn_sig_sample_num, ctx->attn_sig_type, rate, dst, num_samples);
+        return num_samples;
+
+      default:
+        samething_core_silence_gen(dst, num_samples);
+        return num_samples;
+    }
+  }
+
+  switch (kind) {
+    case SAMETHING_CORE_SEQ_KIND_AFSK_HEADER:
+      return samething_core_afsk_render(
+          afsk, ctx->header_plan, ctx->header_plan_size,
+          SAMETHING_CORE_PREAMBLE_NUM, dst, num_samples);
+
+    case SAMETHING_CORE_SEQ_KIND_AFSK_EOM:
+      return samething_core_afsk_render(afsk, NULL, 0,
+                                        SAMETHING_CORE_EOM_HEADER_SIZE, dst,
+                                        num_samples);
+
+    case SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL:
+      samething_core_attn_sig_render(attn_sig_sample_num, ctx->attn_sig_type,
+                                     dst, num_samples);
+      return num_samples;
+
+    case SAMETHING_CORE_SEQ_KIND_SILENCE:
+      samething_core_silence_gen(dst, num_samples);
+      return num_samples;
+
+    default:
+      SAMETHING_UNREACHABLE;
+      return 0;
+  }
+}
+
+size_t samething_core_samples_render(
+    struct samething_core_gen_ctx *const restrict ctx,
+    int16_t *const restrict dst, const size_t dst_size) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT((dst != NULL) || (dst_size == 0));
+
+  return samething_core_cursor_render(ctx, &ctx->cursor, dst, dst_size);
+}
+
+size_t samething_core_samples_gen(
+    struct samething_core_gen_ctx *const restrict ctx,
+    int16_t *const restrict sample_data) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(sample_data != NULL);
+
+  // Tried to generate a SAME header using a context for which a SAME header was
+  // already generated; bug.
+  SAMETHING_ASSERT(ctx->cursor.seq_state < ctx->seq_plan_size);
+
+  return samething_core_samples_render(ctx, sample_data,
+                                       SAMETHING_CORE_SAMPLES_NUM_MAX);
+}
+
+size_t samething_core_half_render(
+    struct samething_core_gen_ctx *const restrict ctx,
+    int16_t *const restrict buffer, const size_t half_size,
+    const unsigned int half) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(buffer != NULL);
+  SAMETHING_ASSERT(half_size > 0);
+  SAMETHING_ASSERT(half < 2);
+
+  int16_t *const dst = &buffer[half * half_size];
+  const size_t num_samples =
+      samething_core_cursor_render(ctx, &ctx->cursor, dst, half_size);
+
+  // The DMA engine drains the whole half regardless.
+  samething_core_silence_gen(&dst[num_samples], half_size - num_samples);
+  return num_samples;
+}
+
+#ifndef SAMETHING_CORE_TINY
+size_t samething_core_segments_build(
+    const struct samething_core_gen_ctx *const restrict ctx,
+    int16_t *const restrict burst,
+    struct samething_core_segment *const restrict segments) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(burst != NULL);
+  SAMETHING_ASSERT(segments != NULL);
+
+  // Generation must not have started yet.
+  SAMETHING_ASSERT(ctx->cursor.seq_state == 0);
+  SAMETHING_ASSERT(ctx->cursor.afsk.rom_pos == 0);
+
+  // The shared waveform tables only exist at the default sample rate.
+  SAMETHING_ASSERT(ctx->sample_rate == 0);
+
+  const size_t burst_samples = samething_core_seq_kind_samples_num(
+      ctx, SAMETHING_CORE_SEQ_KIND_AFSK_HEADER);
+
+  struct samething_core_afsk_state afsk = {0};
+
+  samething_core_afsk_render(&afsk, ctx->header_plan, ctx->header_plan_size,
+                             SAMETHING_CORE_PREAMBLE_NUM, burst, burst_samples);
+
+  size_t num_segments = 0;
+
+  for (size_t state = 0; state < ctx->seq_plan_size; ++state) {
+    // Silence is shared by every sample rate, so it is the fallback.
+    const int16_t *samples = SAMETHING_CORE_SILENCE;
+    size_t period = SAMETHING_CORE_SILENCE_TABLE_SIZE;
+
+    switch (ctx->seq_plan[state].kind) {
+      case SAMETHING_CORE_SEQ_KIND_AFSK_HEADER:
+        samples = burst;
+        period = burst_samples;
+        break;
+
+      case SAMETHING_CORE_SEQ_KIND_AFSK_EOM:
+        samples = samething_core_eom_table;
+        period = SAMETHING_CORE_EOM_SAMPLES_NUM;
+        break;
+
+      case SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL:
+        if (ctx->attn_sig_type == SAMETHING_CORE_ATTN_SIG_TYPE_NWR) {
+          samples = samething_core_attn_sig_nwr_table;
+          period = SAMETHING_CORE_ATTN_SIG_NWR_TABLE_SIZE;
+        } else {
+          samples = samething_core_attn_sig_table;
+          period = SAMETHING_CORE_ATTN_SIG_PERIOD;
+        }
+        break;
+
+      case SAMETHING_CORE_SEQ_KIND_SILENCE:
+        break;
+
+      default:
+        SAMETHING_UNREACHABLE;
+        break;
+    }
+
+    // Split anything longer than its waveform into repeats of it.
+    for (size_t remaining = ctx->seq_plan[state].num_samples; remaining > 0;) {
+      const size_t num_samples = (remaining > period) ? period : remaining;
+
+      SAMETHING_ASSERT(num_segments < SAMETHING_CORE_SEGMENTS_NUM_MAX);
+
+      segments[num_segments].samples = samples;
+      segments[num_segments].num_samples = num_samples;
+      num_segments++;
+
+      remaining -= num_samples;
+    }
+  }
+  return num_segments;
+}
+#endif  // SAMETHING_CORE_TINY
+
+size_t samething_core_seq_spans_get(
+    const struct samething_core_gen_ctx *const restrict ctx,
+    struct samething_core_seq_span *const restrict spans) {
+  SAMETHING_ASSERT(ctx != NULL);
+
+  size_t start = 0;
+
+  for (size_t state = 0; state < ctx->seq_plan_size; ++state) {
+    const size_t num_samples = ctx->seq_plan[state].num_samples;
+
+    if (spans != NULL) {
+      spans[state].start = start;
+      spans[state].num_samples = num_samples;
+    }
+    start += num_samples;
+  }
+  return start;
+}
+
+/// Positions an AFSK burst at a sample within it.
+///
+/// @param afsk The state of the burst, which must be cleared.
+/// @param plan The bit plan of the part of the burst which follows the part
+///             covered by the ROM.
+/// @param plan_size The number of runs in the bit plan.
+/// @param rom_size The number of leading bytes of the burst which are the same
+///                 as those of the End of Message (EOM) burst.
+/// @param sample_offset The sample to position the burst at.
+static void samething_core_afsk_seek(
+    struct samething_core_afsk_state *const restrict afsk,
+    const uint8_t *const restrict plan, const size_t plan_size,
+    const size_t rom_size, const size_t sample_offset) {
+  const size_t rom_samples = rom_size * SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+                             SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+
+  if (sample_offset < rom_samples) {
+    afsk->rom_pos = sample_offset;
+    return;
+  }
+  afsk->rom_pos = rom_samples;
+
+  size_t offset = sample_offset - rom_samples;
+
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  afsk->phase = samething_core_eom_phases[rom_size];
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+
+  // Runs are at most SAMETHING_CORE_AFSK_RUN_BITS_MAX bits long, so this skips
+  // whole runs rather than bits.
+  for (; afsk->run_pos < plan_size; afsk->run_pos++) {
+    const uint8_t symbol = plan[afsk->run_pos];
+    const size_t run_samples = (symbol & SAMETHING_CORE_AFSK_RUN_LEN_MASK) *
+                               SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+    const unsigned int bit = (symbol & SAMETHING_CORE_AFSK_RUN_MARK) ? 1 : 0;
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+
+    if (offset < run_samples) {
+      afsk->sample_num = (unsigned int)offset;
+
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+      // The waveform of a run is only rendered when it starts, so render the
+      // one we're landing in the middle of here.
+      if (offset > 0) {
+        samething_core_afsk_tone_render(
+            afsk->run_wave, bit, afsk->phase,
+            symbol & SAMETHING_CORE_AFSK_RUN_LEN_MASK);
+      }
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+      return;
+    }
+    offset -= run_samples;
+
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+    afsk->phase += SAMETHING_CORE_AFSK_PHASE_INC[bit] * (uint32_t)run_samples;
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  }
+
+  // The offset is always within the burst, so we should never get here.
+  SAMETHING_UNREACHABLE;
+}
+
+void samething_core_cursor_seek(
+    const struct samething_core_gen_ctx *const restrict ctx,
+    struct samething_core_cursor *const restrict cursor,
+    const size_t sample_offset) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(cursor != NULL);
+
+  memset(cursor, 0, sizeof(*cursor));
+
+  size_t offset = sample_offset;
+
+  for (size_t state = 0; state < ctx->seq_plan_size; ++state) {
+    const size_t num_samples = ctx->seq_plan[state].num_samples;
+
+    if (offset >= num_samples) {
+      offset -= num_samples;
+      continue;
+    }
+
+    cursor->seq_state = (unsigned int)state;
+    cursor->seq_samples_remaining = num_samples - offset;
+
+    switch (ctx->seq_plan[state].kind) {
+      case SAMETHING_CORE_SEQ_KIND_AFSK_HEADER:
+        if (ctx->sample_rate != 0) {
+          // With an exact bit clock, the phase follows from the position
+          // alone.
+          cursor->afsk.burst_pos = offset;
+        } else {
+          samething_core_afsk_seek(&cursor->afsk, ctx->header_plan,
+                                   ctx->header_plan_size,
+                                   SAMETHING_CORE_PREAMBLE_NUM, offset);
+        }
+        break;
+
+      case SAMETHING_CORE_SEQ_KIND_AFSK_EOM:
+        if (ctx->sample_rate != 0) {
+          cursor->afsk.burst_pos = offset;
+        } else {
+          samething_core_afsk_seek(&cursor->afsk, NULL, 0,
+                                   SAMETHING_CORE_EOM_HEADER_SIZE, offset);
+        }
+        break;
+
+      case SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL: {
+        // The attention signal repeats every second at any sample rate.
+        const size_t period = (ctx->sample_rate != 0)
+                                  ? ctx->sample_rate
+                                  : SAMETHING_CORE_ATTN_SIG_PERIOD;
+
+        cursor->attn_sig_sample_num = (unsigned int)(offset % period);
+        break;
+      }
+
+      default:
+        // Silence has no state to speak of.
+        break;
+    }
+    return;
+  }
+
+  // The offset is at or past the end of the message.
+  cursor->seq_state = (unsigned int)ctx->seq_plan_size;
+}
+
+size_t samething_core_cursor_render(
+    const struct samething_core_gen_ctx *const restrict ctx,
+    struct samething_core_cursor *const restrict cursor,
+    int16_t *const restrict dst, const size_t dst_size) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(cursor != NULL);
+  SAMETHING_ASSERT((dst != NULL) || (dst_size == 0));
+
+  size_t sample_count = 0;
+
+  while ((sample_count < dst_size) &&
+         (cursor->seq_state < ctx->seq_plan_size)) {
+    size_t num_samples = dst_size - sample_count;
+
+    if (num_samples > cursor->seq_samples_remaining) {
+      num_samples = cursor->seq_samples_remaining;
+    }
+
+    num_samples = samething_core_seq_state_render(
+        ctx, ctx->seq_plan[cursor->seq_state].kind, &cursor->afsk,
+        &cursor->attn_sig_sample_num, &dst[sample_count], num_samples);
+
+    sample_count += num_samples;
+    cursor->seq_samples_remaining -= num_samples;
+
+    // Move on to the next step which isn't empty.
+    while ((cursor->seq_samples_remaining == 0) &&
+           (cursor->seq_state < ctx->seq_plan_size)) {
+      cursor->seq_state++;
+
+      if (cursor->seq_state < ctx->seq_plan_size) {
+        cursor->seq_samples_remaining =
+            ctx->seq_plan[cursor->seq_state].num_samples;
+      }
+    }
+  }
+  return sample_count;
+}
+
+size_t samething_core_range_render(
+    const struct samething_core_gen_ctx *const restrict ctx,
+    const size_t sample_offset, int16_t *const restrict dst,
+    const size_t num_samples) {
+  struct samething_core_cursor cursor;
+
+  samething_core_cursor_seek(ctx, &cursor, sample_offset);
+  return samething_core_cursor_render(ctx, &cursor, dst, num_samples);
+}
+
+void samething_core_seek(struct samething_core_gen_ctx *const ctx,
+                         const size_t sample_offset) {
+  SAMETHING_ASSERT(ctx != NULL);
+
+  samething_core_cursor_seek(ctx, &ctx->cursor, sample_offset);
+}
+
+void samething_core_ctx_pool_init(
+    struct samething_core_ctx_pool *const restrict pool,
+    struct samething_core_gen_ctx *const restrict ctxs, const size_t num_ctxs) {
+  SAMETHING_ASSERT(pool != NULL);
+  SAMETHING_ASSERT((ctxs != NULL) || (num_ctxs == 0));
+
+  pool->ctxs = ctxs;
+  pool->num_ctxs = num_ctxs;
+  pool->free_head = 0;
+  pool->num_free = num_ctxs;
+
+  // Each free context holds the index of the next one where the number of
+  // samples remaining in its sequence state would otherwise be.
+  for (size_t i = 0; i < num_ctxs; ++i) {
+    ctxs[i].cursor.seq_samples_remaining = i + 1;
+  }
+}
+
+struct samething_core_gen_ctx *samething_core_ctx_pool_acquire(
+    struct samething_core_ctx_pool *const restrict pool,
+    const struct samething_core_header *const restrict header,
+    const unsigned int sample_rate) {
+  SAMETHING_ASSERT(pool != NULL);
+  SAMETHING_ASSERT(header != NULL);
+
+  if (pool->num_free == 0) {
+    return NULL;
+  }
+
+  struct samething_core_gen_ctx *const ctx = &pool->ctxs[pool->free_head];
+
+  pool->free_head = ctx->cursor.seq_samples_remaining;
+  pool->num_free--;
+
+  if (sample_rate != 0) {
+    samething_core_ctx_rate_init(ctx, header, sample_rate);
+  } else {
+    samething_core_ctx_init(ctx, header);
+  }
+  return ctx;
+}
+
+void samething_core_ctx_pool_release(
+    struct samething_core_ctx_pool *const restrict pool,
+    struct samething_core_gen_ctx *const restrict ctx) {
+  SAMETHING_ASSERT(pool != NULL);
+  SAMETHING_ASSERT(ctx != NULL);
+
+  // The generation context doesn't belong to the pool.
+  SAMETHING_ASSERT((ctx >= pool->ctxs) &&
+                   (ctx < &pool->ctxs[pool->num_ctxs]));
+
+  // More generation contexts were returned than were taken.
+  SAMETHING_ASSERT(pool->num_free < pool->num_ctxs);
+
+  ctx->cursor.seq_samples_remaining = pool->free_head;
+  pool->free_head = (size_t)(ctx - pool->ctxs);
+  pool->num_free++;
+}
+
+/// Applies a channel gain to a sample.
+///
+/// @param sample The sample to apply the gain to.
+/// @param gain The gain to apply; see SAMETHING_CORE_CHANNEL_GAIN().
+/// @returns The sample with the gain applied, saturated to the range of
+///          int16_t.
+static SAMETHING_ALWAYS_INLINE int16_t
+samething_core_channel_gain_apply(const int16_t sample, const int16_t gain) {
+  const int32_t out = (sample * gain) >> 14;
+
+  if (out > INT16_MAX) {
+    return INT16_MAX;
+  }
+
+  if (out < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return (int16_t)out;
+}
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+/// The number of frames fanned out at once by the vectorized kernel.
+#define SAMETHING_CORE_CHANNELS_BLOCK (8U)
+
+/// Fans out a block of frames to a channel count which divides the block size,
+/// so that every vector of output holds whole frames and the same pattern of
+/// gains.
+///
+/// @param dst The buffer to write the interleaved frames to.
+/// @param src The mono samples to fan out.
+/// @param num_frames The number of frames; this must be a multiple of
+///                   SAMETHING_CORE_CHANNELS_BLOCK.
+/// @param gains The gain of each output lane.
+/// @param num_channels The number of channels, which must be 1, 2, 4 or 8.
+static void samething_core_channels_interleave_simd(
+    int16_t *const dst, const int16_t *const src, const size_t num_frames,
+    const int16_t gains[SAMETHING_CORE_CHANNELS_BLOCK],
+    const unsigned int num_channels) {
+#ifdef __SSE2__
+  const __m128i gain = _mm_loadu_si128((const __m128i *)(const void *)gains);
+
+  for (size_t frame = 0; frame < num_frames;
+       frame += SAMETHING_CORE_CHANNELS_BLOCK) {
+    // Each sample is duplicated once per doubling of the channel count; all
+    // loads happen before any store, as the caller may fan out in place.
+    __m128i vecs[SAMETHING_CORE_CHANNELS_NUM_MAX];
+    unsigned int num_vecs = 1;
+
+    vecs[0] = _mm_loadu_si128((const __m128i *)(const void *)&src[frame]);
+
+    for (unsigned int width = 1; width < num_channels; width *= 2) {
+      for (unsigned int i = num_vecs; i-- > 0;) {
+        const __m128i v = vecs[i];
+
+        if (width == 1) {
+          vecs[(i * 2) + 0] = _mm_unpacklo_epi16(v, v);
+          vecs[(i * 2) + 1] = _mm_unpackhi_epi16(v, v);
+        } else if (width == 2) {
+          vecs[(i * 2) + 0] = _mm_unpacklo_epi32(v, v);
+          vecs[(i * 2) + 1] = _mm_unpackhi_epi32(v, v);
+        } else {
+          vecs[(i * 2) + 0] = _mm_unpacklo_epi64(v, v);
+          vecs[(i * 2) + 1] = _mm_unpackhi_epi64(v, v);
+        }
+      }
+      num_vecs *= 2;
+    }
+
+    for (unsigned int i = 0; i < num_vecs; ++i) {
+      // Widen the products to 32 bits, scale them back down and narrow them
+      // again with saturation.
+      const __m128i lo = _mm_mullo_epi16(vecs[i], gain);
+      const __m128i hi = _mm_mulhi_epi16(vecs[i], gain);
+      const __m128i out =
+          _mm_packs_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 14),
+                          _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 14));
+
+      _mm_storeu_si128(
+          (__m128i *)(void *)&dst[(frame * num_channels) +
+                                  (i * SAMETHING_CORE_CHANNELS_BLOCK)],
+          out);
+    }
+  }
+#else
+  const int16x8_t gain = vld1q_s16(gains);
+
+  for (size_t frame = 0; frame < num_frames;
+       frame += SAMETHING_CORE_CHANNELS_BLOCK) {
+    // Each sample is duplicated once per doubling of the channel count; all
+    // loads happen before any store, as the caller may fan out in place.
+    int16x8_t vecs[SAMETHING_CORE_CHANNELS_NUM_MAX];
+    unsigned int num_vecs = 1;
+
+    vecs[0] = vld1q_s16(&src[frame]);
+
+    for (unsigned int width = 1; width < num_channels; width *= 2) {
+      for (unsigned int i = num_vecs; i-- > 0;) {
+        const int16x8_t v = vecs[i];
+
+        if (width == 1) {
+          const int16x8x2_t zip = vzipq_s16(v, v);
+
+          vecs[(i * 2) + 0] = zip.val[0];
+          vecs[(i * 2) + 1] = zip.val[1];
+        } else if (width == 2) {
+          const int32x4x2_t zip =
+              vzipq_s32(vreinterpretq_s32_s16(v), vreinterpretq_s32_s16(v));
+
+          vecs[(i * 2) + 0] = vreinterpretq_s16_s32(zip.val[0]);
+          vecs[(i * 2) + 1] = vreinterpretq_s16_s32(zip.val[1]);
+        } else {
+          vecs[(i * 2) + 0] = vcombine_s16(vget_low_s16(v), vget_low_s16(v));
+          vecs[(i * 2) + 1] =
+              vcombine_s16(vget_high_s16(v), vget_high_s16(v));
+        }
+      }
+      num_vecs *= 2;
+    }
+
+    for (unsigned int i = 0; i < num_vecs; ++i) {
+      const int32x4_t lo =
+          vmull_s16(vget_low_s16(vecs[i]), vget_low_s16(gain));
+      const int32x4_t hi =
+          vmull_s16(vget_high_s16(vecs[i]), vget_high_s16(gain));
+
+      vst1q_s16(&dst[(frame * num_channels) +
+                     (i * SAMETHING_CORE_CHANNELS_BLOCK)],
+                vcombine_s16(vqshrn_n_s32(lo, 14), vqshrn_n_s32(hi, 14)));
+    }
+  }
+#endif  // __SSE2__
+}
+#endif  // defined(__SSE2__) || defined(__ARM_NEON)
+
+void samething_core_channels_interleave(
+    const struct samething_core_channel_map *const map, int16_t *const dst,
+    const int16_t *const src, const size_t num_frames) {
+  SAMETHING_ASSERT(map != NULL);
+  SAMETHING_ASSERT((map->num_channels >= 1) &&
+                   (map->num_channels <= SAMETHING_CORE_CHANNELS_NUM_MAX));
+  SAMETHING_ASSERT((dst != NULL) || (num_frames == 0));
+  SAMETHING_ASSERT((src != NULL) || (num_frames == 0));
+
+  const unsigned int num_channels = map->num_channels;
+  int16_t gains[SAMETHING_CORE_CHANNELS_NUM_MAX];
+
+  for (unsigned int channel = 0; channel < num_channels; ++channel) {
+    gains[channel] =
+        (map->mute_mask & (1U << channel)) ? 0 : map->gains[channel];
+  }
+
+  size_t frame = 0;
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+  if ((SAMETHING_CORE_CHANNELS_BLOCK % num_channels) == 0) {
+    int16_t lane_gains[SAMETHING_CORE_CHANNELS_BLOCK];
+
+    for (unsigned int lane = 0; lane < SAMETHING_CORE_CHANNELS_BLOCK; ++lane) {
+      lane_gains[lane] = gains[lane % num_channels];
+    }
+
+    frame = num_frames - (num_frames % SAMETHING_CORE_CHANNELS_BLOCK);
+    samething_core_channels_interleave_simd(dst, src, frame, lane_gains,
+                                            num_channels);
+  }
+#endif  // defined(__SSE2__) || defined(__ARM_NEON)
+
+  for (; frame < num_frames; ++frame) {
+    const int16_t sample = src[frame];
+
+    for (unsigned int channel = 0; channel < num_channels; ++channel) {
+      dst[(frame * num_channels) + channel] =
+          samething_core_channel_gain_apply(sample, gains[channel]);
+    }
+  }
+}
+
+size_t samething_core_frames_render(
+    struct samething_core_gen_ctx *const ctx,
+    const struct samething_core_channel_map *const map, int16_t *const dst,
+    const size_t dst_frames) {
+  SAMETHING_ASSERT(ctx != NULL);
+  SAMETHING_ASSERT(map != NULL);
+  SAMETHING_ASSERT((map->num_channels >= 1) &&
+                   (map->num_channels <= SAMETHING_CORE_CHANNELS_NUM_MAX));
+  SAMETHING_ASSERT((dst != NULL) || (dst_frames == 0));
+
+  // The mono samples are generated into the end of the buffer, then fanned out
+  // from the front; every frame is written only after its sample was read.
+  int16_t *const mono = &dst[dst_frames * (map->num_channels - 1)];
+  const size_t num_frames =
+      samething_core_samples_render(ctx, mono, dst_frames);
+
+  samething_core_channels_interleave(map, dst, mono, num_frames);
+  return num_frames;
 }
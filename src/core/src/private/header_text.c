@@ -0,0 +1,393 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file header_text.c
+ * Converts headers to and from the text they're transmitted as.
+ *
+ * Ingesting alerts means parsing a great many headers, so the parser does as
+ * little as it can per character: every field has a fixed length, and each
+ * character is checked by looking its class up in a table. A whole field is
+ * checked without branching by combining the classes of all of its characters;
+ * the field is only scanned again, to find exactly where the offending
+ * character is, if that fails.
+ */
+
+#include <string.h>
+
+#include "samething/core.h"
+#include "samething/compiler.h"
+#include "samething/debug.h"
+
+/// The class of the characters allowed in the location codes, the valid time
+/// period and the originator time.
+#define SAMETHING_CORE_CHAR_CLASS_DIGIT (UINT8_C(1) << 0U)
+
+/// The class of the characters allowed in the originator and event codes.
+#define SAMETHING_CORE_CHAR_CLASS_ALPHA (UINT8_C(1) << 1U)
+
+/// The class of the characters allowed in the callsign: everything printable
+/// but the separators.
+#define SAMETHING_CORE_CHAR_CLASS_CALLSIGN (UINT8_C(1) << 2U)
+
+/// The classes of each character.
+static const uint8_t SAMETHING_CORE_CHAR_CLASSES[256] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00, 0x04, 0x04,
+    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00
+};
+
+/// The identifier every header starts with.
+static const char SAMETHING_CORE_ASCII_ID[SAMETHING_CORE_ASCII_ID_LEN] = {
+    'Z', 'C', 'Z', 'C'};
+
+/// Finds the first character of a field which isn't of a class.
+///
+/// @param field The field to check.
+/// @param field_len The length of the field.
+/// @param char_class The class every character must be of.
+/// @returns The offset of the first character which isn't of the class, or
+///          field_len if they all are.
+static size_t samething_core_field_check(const char *const field,
+                                         const size_t field_len,
+                                         const uint8_t char_class) {
+  uint8_t classes = char_class;
+
+  for (size_t i = 0; i < field_len; ++i) {
+    classes &= SAMETHING_CORE_CHAR_CLASSES[(uint8_t)field[i]];
+  }
+
+  if (classes != 0) {
+    return field_len;
+  }
+
+  size_t pos = 0;
+
+  while ((SAMETHING_CORE_CHAR_CLASSES[(uint8_t)field[pos]] & char_class) != 0) {
+    pos++;
+  }
+  return pos;
+}
+
+/// Parses a field of a header.
+///
+/// @param text The text to parse.
+/// @param text_len The length of the text.
+/// @param pos The offset of the field within the text, which is moved past
+///            it, or to where the error was found.
+/// @param field The buffer to store the field to, which must be able to hold
+///              field_len + 1 characters. The field is terminated.
+/// @param field_len The length of the field.
+/// @param char_class The class every character of the field must be of.
+/// @returns What is wrong with the field, if anything.
+static enum samething_core_parse_error samething_core_field_parse(
+    const char *restrict const text, const size_t text_len,
+    size_t *restrict const pos, char *restrict const field,
+    const size_t field_len, const uint8_t char_class) {
+  const size_t avail = text_len - *pos;
+  const size_t len = (avail < field_len) ? avail : field_len;
+  const size_t bad = samething_core_field_check(&text[*pos], len, char_class);
+
+  if (bad < len) {
+    *pos += bad;
+    return SAMETHING_CORE_PARSE_ERROR_CHARACTER;
+  }
+
+  if (len < field_len) {
+    *pos = text_len;
+    return SAMETHING_CORE_PARSE_ERROR_TRUNCATED;
+  }
+
+  memcpy(field, &text[*pos], field_len);
+  field[field_len] = '\0';
+
+  *pos += field_len;
+  return SAMETHING_CORE_PARSE_ERROR_NONE;
+}
+
+/// Parses the separator which follows a field of a header.
+///
+/// @param text The text to parse.
+/// @param text_len The length of the text.
+/// @param pos The offset of the separator within the text, which is moved
+///            past it if it's the one expected.
+/// @param separator The separator expected.
+/// @returns What is wrong with the separator, if anything.
+static enum samething_core_parse_error samething_core_separator_parse(
+    const char *const text, const size_t text_len, size_t *const pos,
+    const char separator) {
+  if (*pos >= text_len) {
+    return SAMETHING_CORE_PARSE_ERROR_TRUNCATED;
+  }
+
+  if (text[*pos] != separator) {
+    return SAMETHING_CORE_PARSE_ERROR_SEPARATOR;
+  }
+
+  (*pos)++;
+  return SAMETHING_CORE_PARSE_ERROR_NONE;
+}
+
+/// Converts digits which have already been validated into a number.
+///
+/// @param digits The digits to convert.
+/// @param num_digits The number of digits.
+/// @returns The number.
+static unsigned int samething_core_digits_value(const char *const digits,
+                                                const size_t num_digits) {
+  unsigned int value = 0;
+
+  for (size_t i = 0; i < num_digits; ++i) {
+    value = (value * 10U) + (unsigned int)(digits[i] - '0');
+  }
+  return value;
+}
+
+/// Parses and validates the text of a header.
+///
+/// @param header The header to store the fields to.
+/// @param text The text to parse.
+/// @param text_len The length of the text.
+/// @param pos Where to store how far parsing got, which is where the error was
+///            found if there is one.
+/// @returns What is wrong with the text, if anything.
+static enum samething_core_parse_error samething_core_header_text_parse(
+    struct samething_core_header *restrict const header,
+    const char *restrict const text, const size_t text_len,
+    size_t *restrict const pos) {
+  enum samething_core_parse_error error;
+
+  for (*pos = 0; *pos < SAMETHING_CORE_ASCII_ID_LEN; ++(*pos)) {
+    if (*pos >= text_len) {
+      return SAMETHING_CORE_PARSE_ERROR_TRUNCATED;
+    }
+
+    if (text[*pos] != SAMETHING_CORE_ASCII_ID[*pos]) {
+      return SAMETHING_CORE_PARSE_ERROR_ASCII_ID;
+    }
+  }
+
+  if (((error = samething_core_separator_parse(text, text_len, pos, '-')) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE) ||
+      ((error = samething_core_field_parse(
+            text, text_len, pos, header->originator_code,
+            SAMETHING_CORE_ORIGINATOR_CODE_LEN,
+            SAMETHING_CORE_CHAR_CLASS_ALPHA)) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE) ||
+      ((error = samething_core_separator_parse(text, text_len, pos, '-')) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE) ||
+      ((error = samething_core_field_parse(
+            text, text_len, pos, header->event_code,
+            SAMETHING_CORE_EVENT_CODE_LEN, SAMETHING_CORE_CHAR_CLASS_ALPHA)) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE)) {
+    return error;
+  }
+
+  // Every location code is preceded by a dash, and the last one is followed
+  // by a plus.
+  size_t num_codes = 0;
+
+  while ((*pos < text_len) && (text[*pos] == '-')) {
+    if (num_codes == SAMETHING_CORE_LOCATION_CODES_NUM_MAX) {
+      return SAMETHING_CORE_PARSE_ERROR_LOCATION_CODES_NUM;
+    }
+    (*pos)++;
+
+    if ((error = samething_core_field_parse(
+             text, text_len, pos, header->location_codes[num_codes],
+             SAMETHING_CORE_LOCATION_CODE_LEN,
+             SAMETHING_CORE_CHAR_CLASS_DIGIT)) !=
+        SAMETHING_CORE_PARSE_ERROR_NONE) {
+      return error;
+    }
+    num_codes++;
+  }
+
+  if ((error = samething_core_separator_parse(text, text_len, pos, '+')) !=
+      SAMETHING_CORE_PARSE_ERROR_NONE) {
+    return error;
+  }
+
+  if (num_codes == 0) {
+    (*pos)--;
+    return SAMETHING_CORE_PARSE_ERROR_LOCATION_CODES_NUM;
+  }
+
+  if (num_codes < SAMETHING_CORE_LOCATION_CODES_NUM_MAX) {
+    memcpy(header->location_codes[num_codes],
+           SAMETHING_CORE_LOCATION_CODE_END_MARKER,
+           sizeof(SAMETHING_CORE_LOCATION_CODE_END_MARKER));
+  }
+
+  const size_t period_pos = *pos;
+
+  if ((error = samething_core_field_parse(
+           text, text_len, pos, header->valid_time_period,
+           SAMETHING_CORE_VALID_TIME_PERIOD_LEN,
+           SAMETHING_CORE_CHAR_CLASS_DIGIT)) !=
+      SAMETHING_CORE_PARSE_ERROR_NONE) {
+    return error;
+  }
+
+  // The valid time period is HHMM.
+  if (samething_core_digits_value(&header->valid_time_period[2], 2) > 59U) {
+    *pos = period_pos + 2;
+    return SAMETHING_CORE_PARSE_ERROR_VALUE;
+  }
+
+  const size_t time_pos = *pos + 1;
+
+  if (((error = samething_core_separator_parse(text, text_len, pos, '-')) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE) ||
+      ((error = samething_core_field_parse(
+            text, text_len, pos, header->originator_time,
+            SAMETHING_CORE_ORIGINATOR_TIME_LEN,
+            SAMETHING_CORE_CHAR_CLASS_DIGIT)) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE)) {
+    return error;
+  }
+
+  // The originator time is JJJHHMM, where JJJ is the day of the year.
+  const unsigned int day =
+      samething_core_digits_value(header->originator_time, 3);
+
+  if ((day < 1U) || (day > 366U)) {
+    *pos = time_pos;
+    return SAMETHING_CORE_PARSE_ERROR_VALUE;
+  }
+
+  if (samething_core_digits_value(&header->originator_time[3], 2) > 23U) {
+    *pos = time_pos + 3;
+    return SAMETHING_CORE_PARSE_ERROR_VALUE;
+  }
+
+  if (samething_core_digits_value(&header->originator_time[5], 2) > 59U) {
+    *pos = time_pos + 5;
+    return SAMETHING_CORE_PARSE_ERROR_VALUE;
+  }
+
+  if (((error = samething_core_separator_parse(text, text_len, pos, '-')) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE) ||
+      ((error = samething_core_field_parse(
+            text, text_len, pos, header->callsign,
+            SAMETHING_CORE_CALLSIGN_LEN,
+            SAMETHING_CORE_CHAR_CLASS_CALLSIGN)) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE) ||
+      ((error = samething_core_separator_parse(text, text_len, pos, '-')) !=
+       SAMETHING_CORE_PARSE_ERROR_NONE)) {
+    return error;
+  }
+
+  if (*pos < text_len) {
+    return SAMETHING_CORE_PARSE_ERROR_TRAILING;
+  }
+  return SAMETHING_CORE_PARSE_ERROR_NONE;
+}
+
+enum samething_core_parse_error samething_core_header_parse(
+    struct samething_core_header *restrict const header,
+    const char *restrict const text, const size_t text_len,
+    size_t *restrict const error_pos) {
+  SAMETHING_ASSERT(header != NULL);
+  SAMETHING_ASSERT((text != NULL) || (text_len == 0));
+
+  size_t pos;
+  const enum samething_core_parse_error error =
+      samething_core_header_text_parse(header, text, text_len, &pos);
+
+  if ((error != SAMETHING_CORE_PARSE_ERROR_NONE) && (error_pos != NULL)) {
+    *error_pos = pos;
+  }
+  return error;
+}
+
+/// Appends a field of a header to its text, followed by a separator.
+///
+/// @param text The text to append the field to.
+/// @param pos The length of the text, which is moved past the field.
+/// @param field The field to append.
+/// @param field_len The length of the field.
+/// @param separator The separator which follows the field.
+static void samething_core_field_format(char *restrict const text,
+                                        size_t *restrict const pos,
+                                        const char *restrict const field,
+                                        const size_t field_len,
+                                        const char separator) {
+  memcpy(&text[*pos], field, field_len);
+  *pos += field_len;
+  text[(*pos)++] = separator;
+}
+
+size_t samething_core_header_format(
+    const struct samething_core_header *restrict const header,
+    char *restrict const text) {
+  SAMETHING_ASSERT(header != NULL);
+  SAMETHING_ASSERT(text != NULL);
+
+  size_t pos = 0;
+
+  samething_core_field_format(text, &pos, SAMETHING_CORE_ASCII_ID,
+                              SAMETHING_CORE_ASCII_ID_LEN, '-');
+  samething_core_field_format(text, &pos, header->originator_code,
+                              SAMETHING_CORE_ORIGINATOR_CODE_LEN, '-');
+  samething_core_field_format(text, &pos, header->event_code,
+                              SAMETHING_CORE_EVENT_CODE_LEN, '-');
+
+  for (size_t i = 0; i < SAMETHING_CORE_LOCATION_CODES_NUM_MAX; ++i) {
+    if (memcmp(header->location_codes[i],
+               SAMETHING_CORE_LOCATION_CODE_END_MARKER,
+               SAMETHING_CORE_LOCATION_CODE_LEN) == 0) {
+      break;
+    }
+    samething_core_field_format(text, &pos, header->location_codes[i],
+                                SAMETHING_CORE_LOCATION_CODE_LEN, '-');
+  }
+  text[pos - 1] = '+';
+
+  samething_core_field_format(text, &pos, header->valid_time_period,
+                              SAMETHING_CORE_VALID_TIME_PERIOD_LEN, '-');
+  samething_core_field_format(text, &pos, header->originator_time,
+                              SAMETHING_CORE_ORIGINATOR_TIME_LEN, '-');
+  samething_core_field_format(text, &pos, header->callsign,
+                              SAMETHING_CORE_CALLSIGN_LEN, '-');
+
+  text[pos] = '\0';
+  return pos;
+}
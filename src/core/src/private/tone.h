@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file tone.h
+ * Defines the tone kernels which render the oscillators of the core.
+ */
+
+#ifndef SAMETHING_CORE_TONE_H
+#define SAMETHING_CORE_TONE_H
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "samething/core.h"
+#include "samething/core_sine_table.h"
+
+/// The number of samples a vectorized tone kernel may advance at once.
+///
+/// SAMETHING_CORE_TONE_RENDER_MAX must be a multiple of twice this.
+#define SAMETHING_CORE_TONE_LANES_MAX (8U)
+
+/// The maximum absolute error of the sine and cosine evaluated when anchoring
+/// an oscillator, relative to a full scale of 1.0.
+///
+/// This is well under the quantization step of a signed 16-bit sample
+/// (1 / 32767, or ~3.05e-5), so it never affects more than rounding.
+#define SAMETHING_CORE_SINCOS_ERROR_MAX (1e-6F)
+
+#ifdef SAMETHING_CORE_FIXED_POINT
+/// Converts an amplitude, where 1.0 is full scale, to a tone gain.
+///
+/// Tone gains are Q15 fixed-point values, and must not exceed 2.0.
+#define SAMETHING_CORE_TONE_GAIN(gain) ((int32_t)((gain) * 32768.0F))
+
+/// Defines the per-sample phase increment of an oscillator.
+struct samething_core_tone_step {
+  /// The phase increment, where 2^32 is one full cycle.
+  uint32_t phase_inc;
+};
+#else
+/// Converts an amplitude, where 1.0 is full scale, to a tone gain.
+#define SAMETHING_CORE_TONE_GAIN(gain) ((float)(gain))
+
+/// Defines the per-sample rotation of an oscillator, along with its powers.
+///
+/// Element i of each array holds the rotation applied over i samples, which
+/// allows a vectorized tone kernel to advance several samples at once.
+struct samething_core_tone_step {
+  /// The in-phase (cosine) components of the rotation.
+  float re[SAMETHING_CORE_TONE_LANES_MAX + 1];
+
+  /// The quadrature (sine) components of the rotation.
+  float im[SAMETHING_CORE_TONE_LANES_MAX + 1];
+};
+#endif  // SAMETHING_CORE_FIXED_POINT
+
+/// Defines a tone for a tone kernel to render.
+struct samething_core_tone {
+  /// The rotation to apply to the oscillator each sample.
+  const struct samething_core_tone_step *step;
+
+  /// The phase of the first sample, where 2^32 is one full cycle.
+  uint32_t phase;
+
+  /// The amplitude of the tone; see SAMETHING_CORE_TONE_GAIN().
+#ifdef SAMETHING_CORE_FIXED_POINT
+  int32_t gain;
+#else
+  float gain;
+#endif  // SAMETHING_CORE_FIXED_POINT
+};
+
+/// Renders the sum of one or more tones as signed 16-bit samples.
+///
+/// Samples which fall outside of the range of int16_t are saturated.
+///
+/// @param dst The buffer to render the samples to.
+/// @param num_samples The number of samples to render. This must not exceed
+///                    SAMETHING_CORE_TONE_RENDER_MAX.
+/// @param tones The tones to render.
+/// @param num_tones The number of tones to render.
+typedef void (*samething_core_tone_kernel)(
+    int16_t *const dst, const size_t num_samples,
+    const struct samething_core_tone *const tones, const size_t num_tones);
+
+#ifdef SAMETHING_TESTING
+/// The portable tone kernel. See samething_core_tone_kernel.
+void samething_core_tone_render_scalar(
+    int16_t *const dst, const size_t num_samples,
+    const struct samething_core_tone *const tones, const size_t num_tones);
+
+#ifndef SAMETHING_CORE_FIXED_POINT
+/// Computes the cosine and sine of a phase.
+///
+/// If SAMETHING_CORE_FAST_SINE is defined, a polynomial approximation is used
+/// instead of the C library. Either way, the error of each result is within
+/// SAMETHING_CORE_SINCOS_ERROR_MAX.
+///
+/// @param phase The phase, where 2^32 is one full cycle.
+/// @param re Where to store the cosine of the phase.
+/// @param im Where to store the sine of the phase.
+void samething_core_sincos(const uint32_t phase, float *const re,
+                           float *const im);
+
+#ifdef __SSE2__
+/// The SSE2 tone kernel. See samething_core_tone_kernel.
+void samething_core_tone_render_sse2(
+    int16_t *const dst, const size_t num_samples,
+    const struct samething_core_tone *const tones, const size_t num_tones);
+#endif  // __SSE2__
+
+#if defined(__x86_64__) || defined(__i386__)
+/// The AVX2 tone kernel. See samething_core_tone_kernel.
+///
+/// This must only be called if the host CPU supports AVX2.
+void samething_core_tone_render_avx2(
+    int16_t *const dst, const size_t num_samples,
+    const struct samething_core_tone *const tones, const size_t num_tones);
+#endif  // defined(__x86_64__) || defined(__i386__)
+
+#ifdef __ARM_NEON
+/// The NEON tone kernel. See samething_core_tone_kernel.
+void samething_core_tone_render_neon(
+    int16_t *const dst, const size_t num_samples,
+    const struct samething_core_tone *const tones, const size_t num_tones);
+#endif  // __ARM_NEON
+#endif  // SAMETHING_CORE_FIXED_POINT
+
+/// Selects the fastest tone kernel supported by the host CPU.
+///
+/// @returns The selected tone kernel.
+samething_core_tone_kernel samething_core_tone_kernel_select(void);
+#endif  // SAMETHING_TESTING
+
+#ifdef __cplusplus
+}
+#endif  // __cplusplus
+
+#endif  // SAMETHING_CORE_TONE_H
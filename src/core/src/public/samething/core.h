@@ -33,6 +33,18 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef SAMETHING_CORE_TINY
+// The tiny profile has no waveform tables, and synthesizes everything with
+// integer arithmetic.
+#ifndef SAMETHING_CORE_FIXED_POINT
+#define SAMETHING_CORE_FIXED_POINT
+#endif  // SAMETHING_CORE_FIXED_POINT
+
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+#error "SAMETHING_CORE_TINY doesn't support continuous-phase AFSK"
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+#endif  // SAMETHING_CORE_TINY
+
 /// Consecutive string of bits (sixteen bytes of AB hexadecimal [8 bit byte
 /// 1010'1011]) sent to clear the system, set AGC and set asynchronous decoder
 /// clocking cycles.
@@ -99,8 +111,13 @@ extern "C" {
 ///     [2]: SAMETHING_CORE_LOCATION_CODE_END_MARKER
 #define SAMETHING_CORE_LOCATION_CODE_END_MARKER ("SPOOKY")
 
+#ifndef SAMETHING_CORE_SAMPLES_NUM_MAX
 /// The number of audio samples per each chunk.
+///
+/// This may be defined at build time to match the buffer size of the target,
+/// e.g. 64 samples for small DMA buffers; any value of at least 1 works.
 #define SAMETHING_CORE_SAMPLES_NUM_MAX (4096U)
+#endif  // SAMETHING_CORE_SAMPLES_NUM_MAX
 
 /// The number of audio samples per second.
 ///
@@ -109,6 +126,10 @@ extern "C" {
 /// revealed any issues.
 #define SAMETHING_CORE_SAMPLE_RATE (44100U)
 
+/// The highest sample rate a generation context can be configured to run at;
+/// see samething_core_ctx_rate_init().
+#define SAMETHING_CORE_SAMPLE_RATE_MAX (48000U)
+
 /// The length of a period of silence in seconds.
 #define SAMETHING_CORE_SILENCE_DURATION (1U)
 
@@ -118,10 +139,20 @@ extern "C" {
 /// The second fundamental frequency of the attention signal.
 #define SAMETHING_CORE_ATTN_SIG_FREQ_SECOND (960.0F)
 
+/// The frequency of the NOAA Weather Radio (NWR) warning alarm tone, which NWR
+/// transmitters send as the attention signal instead.
+#define SAMETHING_CORE_ATTN_SIG_NWR_FREQ (1050.0F)
+
 /// The Preamble and EAS codes must use Audio Frequency Shift Keying at a rate
 /// of 520.83 bits per second to transmit the codes.
 #define SAMETHING_CORE_AFSK_BIT_RATE (520.83F)
 
+/// The AFSK bit rate in hundredths of a bit per second.
+///
+/// This exists so that quantities derived from the bit rate can be integer
+/// constant expressions, e.g. for sizing arrays.
+#define SAMETHING_CORE_AFSK_BIT_RATE_X100 (52083U)
+
 /// Mark and space time must be 1.92 milliseconds.
 #define SAMETHING_CORE_AFSK_BIT_DURATION (1.0F / SAMETHING_CORE_AFSK_BIT_RATE)
 
@@ -134,10 +165,10 @@ extern "C" {
 /// How many samples should we generate for each bit during an AFSK burst?
 ///
 /// **WARNING:** The result should always be rounded up!
-#define SAMETHING_CORE_AFSK_SAMPLES_PER_BIT           \
-  ((unsigned int)((SAMETHING_CORE_AFSK_BIT_DURATION * \
-                   SAMETHING_CORE_SAMPLE_RATE) +      \
-                  0.5F))
+#define SAMETHING_CORE_AFSK_SAMPLES_PER_BIT                 \
+  (((SAMETHING_CORE_SAMPLE_RATE * 100U) +                   \
+    (SAMETHING_CORE_AFSK_BIT_RATE_X100 / 2U)) /             \
+   SAMETHING_CORE_AFSK_BIT_RATE_X100)
 
 /// How many bits per character?
 #define SAMETHING_CORE_AFSK_BITS_PER_CHAR (8U)
@@ -148,11 +179,12 @@ extern "C" {
 /// The maximum number of seconds the attention signal can last for.
 #define SAMETHING_CORE_ATTN_SIG_DURATION_MAX (25U)
 
-/// Defines the generation sequence states.
+/// Defines the generation sequence states of the standard sequence plan, which
+/// samething_core_ctx_init() and samething_core_ctx_rate_init() set up.
 ///
 /// The sequence states dictate what portion of the SAME header we are
 /// generating. These states are laid out in the natural order as one would
-/// hear.
+/// hear, and each is the index of its step within the standard sequence plan.
 enum samething_core_seq_state {
   /// First AFSK burst of header
   SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST,
@@ -200,6 +232,94 @@ enum samething_core_seq_state {
   SAMETHING_CORE_SEQ_STATE_NUM
 };
 
+/// The maximum number of steps in a sequence plan.
+#define SAMETHING_CORE_SEQ_PLAN_SIZE_MAX (16U)
+
+/// The maximum number of header bursts, and separately of End of Message (EOM)
+/// bursts, in a sequence plan.
+#define SAMETHING_CORE_SEQ_BURSTS_NUM_MAX (3U)
+
+/// The maximum total duration of the silence in a sequence plan, in
+/// milliseconds; as much as the standard sequence plan has.
+#define SAMETHING_CORE_SEQ_SILENCE_MS_MAX \
+  (7U * SAMETHING_CORE_SILENCE_DURATION * 1000U)
+
+/// Defines what a step of a sequence plan generates, which also determines
+/// where its samples come from.
+enum samething_core_seq_kind {
+  /// An AFSK burst of the header.
+  SAMETHING_CORE_SEQ_KIND_AFSK_HEADER,
+
+  /// An AFSK burst of the End of Message (EOM).
+  SAMETHING_CORE_SEQ_KIND_AFSK_EOM,
+
+  /// The attention signal, for as long as the header specifies.
+  SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL,
+
+  /// A period of silence.
+  SAMETHING_CORE_SEQ_KIND_SILENCE
+};
+
+/// Describes a step of a sequence plan to samething_core_ctx_plan_init().
+struct samething_core_seq_step {
+  /// What the step generates.
+  enum samething_core_seq_kind kind;
+
+  /// How long a period of silence lasts, in milliseconds. This is unused by
+  /// every other kind of step, which lasts as long as what it generates.
+  unsigned int duration_ms;
+};
+
+/// Defines a step of the sequence plan of a generation context.
+struct samething_core_seq_entry {
+  /// The number of samples in the step.
+  uint32_t num_samples;
+
+  /// What the step generates.
+  enum samething_core_seq_kind kind;
+};
+
+/// The maximum number of samples a tone kernel may render in a single call;
+/// the oscillators are anchored again at least this often.
+#define SAMETHING_CORE_TONE_RENDER_MAX (128U)
+
+/// The maximum number of channels samples can be fanned out to.
+#define SAMETHING_CORE_CHANNELS_NUM_MAX (8U)
+
+/// Converts an amplitude, where 1.0 is unity, to a channel gain.
+///
+/// Channel gains are Q14 fixed-point values, and must be less than 2.0.
+#define SAMETHING_CORE_CHANNEL_GAIN(gain) ((int16_t)((gain) * 16384.0F))
+
+/// Defines how mono samples are fanned out to interleaved frames of one or
+/// more channels.
+struct samething_core_channel_map {
+  /// The gain of each channel; see SAMETHING_CORE_CHANNEL_GAIN().
+  int16_t gains[SAMETHING_CORE_CHANNELS_NUM_MAX];
+
+  /// The number of channels in each frame, from 1 to
+  /// SAMETHING_CORE_CHANNELS_NUM_MAX.
+  unsigned int num_channels;
+
+  /// Channel N is silent while bit N is set, regardless of its gain.
+  uint8_t mute_mask;
+};
+
+/// Defines the kinds of attention signal a message can carry.
+enum samething_core_attn_sig_type {
+  /// The two tone attention signal of the Emergency Alert System (EAS), made
+  /// of SAMETHING_CORE_ATTN_SIG_FREQ_FIRST and
+  /// SAMETHING_CORE_ATTN_SIG_FREQ_SECOND.
+  SAMETHING_CORE_ATTN_SIG_TYPE_EAS,
+
+  /// The single tone warning alarm of NOAA Weather Radio (NWR), at
+  /// SAMETHING_CORE_ATTN_SIG_NWR_FREQ.
+  SAMETHING_CORE_ATTN_SIG_TYPE_NWR,
+
+  /// The number of kinds of attention signal.
+  SAMETHING_CORE_ATTN_SIG_TYPE_NUM
+};
+
 /// Defines the header to be used for generating a full SAME header. This is
 /// what users should be using.
 ///
@@ -228,70 +348,300 @@ struct samething_core_header {
 
   /// How long will the attention signal last for?
   unsigned int attn_sig_duration;
+
+  /// Which attention signal is sent; a zeroed header sends the EAS one.
+  enum samething_core_attn_sig_type attn_sig_type;
 };
 
-/// Defines the generation context.
+/// The maximum length of the text of a header, which is everything but the
+/// preamble: "ZCZC-ORG-EEE-PSSCCC+TTTT-JJJHHMM-LLLLLLLL-" with up to
+/// SAMETHING_CORE_LOCATION_CODES_NUM_MAX location codes.
+#define SAMETHING_CORE_HEADER_TEXT_LEN_MAX \
+  (SAMETHING_CORE_HEADER_SIZE_MAX - SAMETHING_CORE_PREAMBLE_NUM)
+
+/// Defines what is wrong with the text of a header which couldn't be parsed.
+enum samething_core_parse_error {
+  /// The text is a valid header.
+  SAMETHING_CORE_PARSE_ERROR_NONE,
+
+  /// The text ends before the header does.
+  SAMETHING_CORE_PARSE_ERROR_TRUNCATED,
+
+  /// The text doesn't start with "ZCZC".
+  SAMETHING_CORE_PARSE_ERROR_ASCII_ID,
+
+  /// A character isn't allowed in the field it's in.
+  SAMETHING_CORE_PARSE_ERROR_CHARACTER,
+
+  /// A field isn't followed by the separator expected after it.
+  SAMETHING_CORE_PARSE_ERROR_SEPARATOR,
+
+  /// A day, hour or minute is out of range.
+  SAMETHING_CORE_PARSE_ERROR_VALUE,
+
+  /// There are no location codes, or more than
+  /// SAMETHING_CORE_LOCATION_CODES_NUM_MAX of them.
+  SAMETHING_CORE_PARSE_ERROR_LOCATION_CODES_NUM,
+
+  /// The text goes on past the end of the header.
+  SAMETHING_CORE_PARSE_ERROR_TRAILING
+};
+
+/// The maximum number of samples in a header burst.
+#define SAMETHING_CORE_HEADER_SAMPLES_NUM_MAX                         \
+  (SAMETHING_CORE_HEADER_SIZE_MAX * SAMETHING_CORE_AFSK_BITS_PER_CHAR * \
+   SAMETHING_CORE_AFSK_SAMPLES_PER_BIT)
+
+/// The maximum number of samples in a message at SAMETHING_CORE_SAMPLE_RATE:
+/// three header bursts of the maximum size, three End of Message (EOM) bursts,
+/// seven periods of silence and the longest attention signal. No sequence plan
+/// holds more than this.
+#define SAMETHING_CORE_MESSAGE_SAMPLES_NUM_MAX                         \
+  (3U * SAMETHING_CORE_HEADER_SAMPLES_NUM_MAX +                        \
+   3U * SAMETHING_CORE_EOM_HEADER_SIZE *                               \
+       SAMETHING_CORE_AFSK_BITS_PER_CHAR *                             \
+       SAMETHING_CORE_AFSK_SAMPLES_PER_BIT +                           \
+   (7U * SAMETHING_CORE_SILENCE_DURATION +                             \
+    SAMETHING_CORE_ATTN_SIG_DURATION_MAX) * SAMETHING_CORE_SAMPLE_RATE)
+
+/// The number of segments each second of the NOAA Weather Radio (NWR)
+/// attention signal is split into. The waveform it repeats is only a fraction
+/// of a second long, which keeps it small.
+#define SAMETHING_CORE_ATTN_SIG_NWR_SEGMENTS_PER_SEC (10U)
+
+/// The number of segments each second of silence is split into. Every segment
+/// of silence shares the same short run of zeros, which keeps it small.
+#define SAMETHING_CORE_SILENCE_SEGMENTS_PER_SEC (10U)
+
+/// The maximum number of segments a message can be split into.
 ///
-/// A generation context keeps track of the audio generation state over each
-/// call to the samething_core_samples_gen function.
-struct samething_core_gen_ctx {
-  // The buffer containing the audio samples.
-  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+/// Every step of the sequence plan is one segment, except for the attention
+/// signal, which is one segment per second or part thereof, and silence, which
+/// is SAMETHING_CORE_SILENCE_SEGMENTS_PER_SEC segments per second. The NWR
+/// attention signal is instead SAMETHING_CORE_ATTN_SIG_NWR_SEGMENTS_PER_SEC
+/// segments per second.
+#define SAMETHING_CORE_SEGMENTS_NUM_MAX                         \
+  (SAMETHING_CORE_SEQ_PLAN_SIZE_MAX +                           \
+   7U * SAMETHING_CORE_SILENCE_DURATION *                       \
+       SAMETHING_CORE_SILENCE_SEGMENTS_PER_SEC +                \
+   SAMETHING_CORE_ATTN_SIG_DURATION_MAX *                       \
+       SAMETHING_CORE_ATTN_SIG_NWR_SEGMENTS_PER_SEC)
+
+/// Defines a contiguous run of samples within a message.
+struct samething_core_segment {
+  /// The samples of the segment.
+  const int16_t *samples;
+
+  /// The number of samples in the segment.
+  size_t num_samples;
+};
 
-  /// The header data to generate an AFSK burst from.
-  uint8_t header_data[SAMETHING_CORE_HEADER_SIZE_MAX];
+/// Defines where a sequence state lies within a message.
+struct samething_core_seq_span {
+  /// The offset of the first sample of the sequence state.
+  size_t start;
+
+  /// The number of samples in the sequence state.
+  size_t num_samples;
+};
+
+/// The maximum number of identical consecutive bits merged into a single run
+/// of a bit plan. This must not exceed 127.
+#define SAMETHING_CORE_AFSK_RUN_BITS_MAX (8U)
+
+/// The maximum number of runs in the bit plan of a header burst.
+#define SAMETHING_CORE_AFSK_PLAN_SIZE_MAX \
+  (SAMETHING_CORE_HEADER_SIZE_MAX * SAMETHING_CORE_AFSK_BITS_PER_CHAR)
+
+/// Defines the state of an AFSK burst in progress.
+struct samething_core_afsk_state {
+  /// The current sample within the part of the burst streamed out of the ROM.
+  size_t rom_pos;
+
+  /// The current run within the bit plan.
+  size_t run_pos;
+
+  /// The current sample within the current run.
+  unsigned int sample_num;
+
+  /// The phase of the oscillator at the start of the current run, where 2^32
+  /// is one full cycle. This is only used when
+  /// SAMETHING_CORE_AFSK_CONTINUOUS_PHASE is defined.
+  uint32_t phase;
+
+  /// The current sample within the burst. This is only used by generation
+  /// contexts with an exact bit clock; see samething_core_ctx_rate_init().
+  size_t burst_pos;
 
-  /// The number of samples remaining for each generation sequence.
-  unsigned int seq_samples_remaining[SAMETHING_CORE_SEQ_STATE_NUM];
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  /// The waveform of the current run.
+  int16_t run_wave[SAMETHING_CORE_AFSK_RUN_BITS_MAX *
+                   SAMETHING_CORE_AFSK_SAMPLES_PER_BIT];
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+};
 
-  struct {
-    /// The current position within the data.
-    size_t data_pos;
+/// The size of a cache line, which the state of a generation in progress is
+/// aligned to.
+#define SAMETHING_CORE_CACHE_LINE_SIZE (64U)
 
-    /// The current bit we're generating a sine wave for.
-    unsigned int bit_pos;
+#ifdef __cplusplus
+#define SAMETHING_CORE_CACHE_ALIGNED alignas(SAMETHING_CORE_CACHE_LINE_SIZE)
+#else
+#define SAMETHING_CORE_CACHE_ALIGNED _Alignas(SAMETHING_CORE_CACHE_LINE_SIZE)
+#endif  // __cplusplus
 
-    /// The current sample we're generating.
-    unsigned int sample_num;
-  } afsk;
+/// Defines a position within a message.
+///
+/// A cursor holds only the state needed to generate samples from where it is;
+/// the message itself is read from a generation context which isn't altered,
+/// so any number of cursors may generate from the same generation context at
+/// once, from different threads.
+///
+/// A cursor is also all of the state a generation context changes as it
+/// generates, so it is kept compact and aligned to a cache line; unless
+/// SAMETHING_CORE_AFSK_CONTINUOUS_PHASE is defined, it fits in one.
+struct samething_core_cursor {
+  /// The state of the AFSK burst being generated.
+  SAMETHING_CORE_CACHE_ALIGNED struct samething_core_afsk_state afsk;
+
+  /// The number of samples remaining in the current sequence state.
+  size_t seq_samples_remaining;
+
+  /// The current step within the sequence plan, which is the number of steps
+  /// in it once the end of the message is reached.
+  unsigned int seq_state;
+
+  /// The current sample we're generating within the period of the attention
+  /// signal.
+  unsigned int attn_sig_sample_num;
+};
+
+/// Defines the generation context.
+///
+/// A generation context holds a message, along with how far along generating
+/// it is. The samples are written to buffers owned by the caller, so the
+/// generation context itself stays small.
+///
+/// Configuring a generation context sets every part of it which is used, so
+/// there is no need to clear one beforehand, whether it's new or reused.
+struct samething_core_gen_ctx {
+  /// How far along generation is. This is the only part of the generation
+  /// context which changes as samples are generated.
+  struct samething_core_cursor cursor;
+
+  /// The number of runs in the bit plan.
+  size_t header_plan_size;
 
   /// The actual size of the header to care about.
   size_t header_size;
 
-  /// The current sequence of the generation.
-  enum samething_core_seq_state seq_state;
+  /// The total number of samples in the attention signal.
+  unsigned int attn_sig_samples_num;
 
-  /// The current sample we're generating for the attention signal.
-  unsigned int attn_sig_sample_num;
+  /// Which attention signal is sent.
+  enum samething_core_attn_sig_type attn_sig_type;
+
+  /// The number of steps in the sequence plan.
+  size_t seq_plan_size;
+
+  /// The sequence plan, which is what the message is made of, in order.
+  struct samething_core_seq_entry seq_plan[SAMETHING_CORE_SEQ_PLAN_SIZE_MAX];
+
+  /// The sample rate of a generation context configured with
+  /// samething_core_ctx_rate_init(), or 0 for one configured with
+  /// samething_core_ctx_init(), which runs at SAMETHING_CORE_SAMPLE_RATE with
+  /// SAMETHING_CORE_AFSK_SAMPLES_PER_BIT samples per bit.
+  unsigned int sample_rate;
+
+  /// The index of the sample rate within the sample rates the core supports,
+  /// which is looked up once when the generation context is configured. For a
+  /// generation context configured with samething_core_ctx_init(), this is the
+  /// index of SAMETHING_CORE_SAMPLE_RATE.
+  unsigned int sample_rate_index;
+
+  /// The header data to generate an AFSK burst from.
+  uint8_t header_data[SAMETHING_CORE_HEADER_SIZE_MAX];
+
+  /// The bit plan of the header data which follows the preamble.
+  ///
+  /// Each entry is a run of identical bits: the most significant bit holds the
+  /// value of the bits, and the rest hold how many there are.
+  uint8_t header_plan[SAMETHING_CORE_AFSK_PLAN_SIZE_MAX];
+};
+
+/// Defines a pool of generation contexts, which hands out the same contexts
+/// over and over again instead of the caller having to set up new ones.
+///
+/// The pool doesn't own the generation contexts; they are supplied by the
+/// caller. Free contexts are linked together through their cursors, so the pool
+/// needs no storage of its own.
+///
+/// A pool is not thread-safe. Each thread should use its own.
+struct samething_core_ctx_pool {
+  /// The generation contexts belonging to the pool.
+  struct samething_core_gen_ctx *ctxs;
+
+  /// The number of generation contexts belonging to the pool.
+  size_t num_ctxs;
+
+  /// The index of the first free generation context, or num_ctxs if there are
+  /// none.
+  size_t free_head;
+
+  /// The number of free generation contexts.
+  size_t num_free;
 };
 
 #ifdef SAMETHING_TESTING
-/// Generates an Audio Frequency Shift Keying (AFSK) burst.
+/// Expands data into a bit plan: a list of runs of identical bits, in the
+/// order they're transmitted.
 ///
-/// @param ctx The generation context in use, which stores the state of the
-///            generation.
-/// @param data The data to generate an AFSK burst from.
-/// @param data_size The size of the data to generate an AFSK burst from.
-/// @param num_samples The number of samples to generate.
-void samething_core_afsk_gen(struct samething_core_gen_ctx *const ctx,
-                             const uint8_t *const data, const size_t data_size,
-                             const size_t sample_pos);
+/// @param plan The buffer to store the bit plan to, which must be able to hold
+///             SAMETHING_CORE_AFSK_BITS_PER_CHAR entries per byte of data.
+/// @param data The data to expand.
+/// @param data_size The size of the data to expand.
+/// @returns The number of runs in the bit plan.
+size_t samething_core_afsk_plan_build(uint8_t *const plan,
+                                      const uint8_t *const data,
+                                      const size_t data_size);
 
-/// Generates silence for a period of 1 second.
+/// Generates an Audio Frequency Shift Keying (AFSK) burst.
+///
+/// Generation stops early if the end of the burst is reached.
 ///
 /// @param ctx The generation context in use, which stores the state of the
 ///            generation.
+/// @param plan The bit plan of the part of the burst which follows the part
+///             streamed out of the ROM.
+/// @param plan_size The number of runs in the bit plan.
+/// @param rom_size The number of leading bytes of the burst which are the same
+///                 as those of the End of Message (EOM) burst. Those are
+///                 streamed out of a pre-rendered table instead of being
+///                 synthesized.
+/// @param dst The buffer to write the samples to.
+/// @param num_samples The maximum number of samples to generate.
+/// @returns The number of samples actually generated.
+size_t samething_core_afsk_gen(struct samething_core_gen_ctx *const ctx,
+                               const uint8_t *const plan,
+                               const size_t plan_size, const size_t rom_size,
+                               int16_t *const dst, const size_t num_samples);
+
+/// Generates silence.
+///
+/// @param dst The buffer to write the samples to.
 /// @param num_samples The number of samples to generate.
-void samething_core_silence_gen(struct samething_core_gen_ctx *const ctx,
-                                const size_t sample_pos);
+void samething_core_silence_gen(int16_t *const dst, const size_t num_samples);
 
-/// Generates the attention signal.
+/// Generates the attention signal of the type the header specified.
+///
+/// The attention signal wraps around seamlessly at the end of each period.
 ///
 /// @param ctx The generation context in use, which stores the state of the
 ///            generation.
+/// @param dst The buffer to write the samples to.
 /// @param num_samples The number of samples to generate.
 void samething_core_attn_sig_gen(struct samething_core_gen_ctx *const ctx,
-                                 const size_t sample_pos);
+                                 int16_t *const dst, const size_t num_samples);
 
 /// Adds a field to the data.
 ///
@@ -306,17 +656,362 @@ void samething_core_field_add(uint8_t *const data, size_t *data_size,
                               const char *const field, const size_t field_len);
 #endif  // SAMETHING_TESTING
 
-/// Configures a generation context to generate the specified header.
+/// Configures a generation context to generate the specified header, from the
+/// start.
+///
+/// The first call also builds the waveform tables shared by all generation
+/// contexts; this is safe to do from multiple threads at once.
 ///
 /// @param ctx The generation context.
 /// @param header The header data to generate a SAME header from.
 void samething_core_ctx_init(struct samething_core_gen_ctx *const ctx,
                              const struct samething_core_header *const header);
 
+/// Configures a generation context to generate the specified header at the
+/// specified sample rate.
+///
+/// The supported sample rates are 8000, 11025, 16000, 22050, 44100 and 48000
+/// Hz. Unlike with samething_core_ctx_init(), bits aren't rounded to a whole
+/// number of samples: the bit clock keeps the exact bit rate of 520 5/6 bits
+/// per second, and each bit starts on the first sample at or after its exact
+/// start time.
+///
+/// samething_core_segments_build() doesn't support such generation contexts.
+///
+/// @param ctx The generation context.
+/// @param header The header data to generate a SAME header from.
+/// @param sample_rate The sample rate to generate at, in Hz.
+void samething_core_ctx_rate_init(
+    struct samething_core_gen_ctx *const ctx,
+    const struct samething_core_header *const header,
+    const unsigned int sample_rate);
+
+/// Configures a generation context to generate the specified header following
+/// a sequence plan of the caller's choosing, from the start.
+///
+/// This allows for messages other than the standard one, such as an End of
+/// Message (EOM) on its own, the header bursts on their own for a
+/// retransmission, or periods of silence of other lengths. The plan is
+/// expanded into the number of samples of each step up front, so generating
+/// just walks it.
+///
+/// A plan may hold up to SAMETHING_CORE_SEQ_BURSTS_NUM_MAX header bursts and as
+/// many EOM bursts, one attention signal, and up to
+/// SAMETHING_CORE_SEQ_SILENCE_MS_MAX milliseconds of silence in total, so that
+/// no message is longer than the standard one can be.
+///
+/// @param ctx The generation context.
+/// @param header The header data to generate a SAME header from.
+/// @param sample_rate The sample rate to generate at, in Hz, as with
+///                    samething_core_ctx_rate_init(), or 0 to generate as
+///                    samething_core_ctx_init() does.
+/// @param steps The steps of the sequence plan, in order.
+/// @param num_steps The number of steps, which must be from 1 to
+///                  SAMETHING_CORE_SEQ_PLAN_SIZE_MAX.
+void samething_core_ctx_plan_init(
+    struct samething_core_gen_ctx *const ctx,
+    const struct samething_core_header *const header,
+    const unsigned int sample_rate,
+    const struct samething_core_seq_step *const steps, const size_t num_steps);
+
+/// Reconfigures a generation context to generate a header which differs from
+/// its current one in only some fields, from the start.
+///
+/// This is meant for reissuing the same alert with, say, only the originator
+/// time changed: the fields are compared against the header data already held,
+/// and only the bytes which differ are rewritten. The header data is rebuilt
+/// from scratch only if the number of location codes changed, as that moves
+/// every field after them.
+///
+/// The samples of the header burst which changed are described by changed, so
+/// that a copy of the burst kept from before (such as the one
+/// samething_core_segments_build() renders) can be brought up to date by
+/// rendering just that span with samething_core_range_render(); in the
+/// standard sequence plan the first burst starts the message, so the span is
+/// also where it lies within the message.
+/// Unless the phase is carried across bits, the span covers only the bits of
+/// the bytes which changed; otherwise it runs to the end of the burst.
+///
+/// The sample rate and sequence plan the generation context was configured
+/// with are kept. The duration and type of the attention signal are taken from
+/// the header, but changes to them aren't part of the span.
+///
+/// @param ctx The generation context, which must have been configured before.
+/// @param header The header data to generate a SAME header from.
+/// @param changed The span of the header burst which changed, which is empty
+///                if nothing did.
+/// @returns true if the header was updated in place, or false if it had to be
+///          rebuilt, in which case the length of the burst may have changed and
+///          any copy of it kept from before must be rendered again in full.
+bool samething_core_header_update(
+    struct samething_core_gen_ctx *const ctx,
+    const struct samething_core_header *const header,
+    struct samething_core_seq_span *const changed);
+
+/// Parses and validates the text of a header, such as
+/// "ZCZC-WXR-TOR-048484+0030-1231200-KEC61/NW-", into a header.
+///
+/// Each character is checked against the class of the field it falls in: the
+/// originator and event codes are upper case letters, the location codes,
+/// valid time period and originator time are digits, and the callsign is any
+/// printable character but a separator. The day of the year, hours and
+/// minutes must also be in range. Location codes end with the end marker,
+/// unless all SAMETHING_CORE_LOCATION_CODES_NUM_MAX of them are used.
+///
+/// The text isn't expected to be terminated; it must hold exactly one header
+/// and nothing else.
+///
+/// @param header The header to store the fields to. The attention signal
+///               duration and type aren't part of the text, so they are left
+///               untouched and must be set by the caller. The rest of the
+///               header is unspecified if the text is invalid.
+/// @param text The text to parse.
+/// @param text_len The length of the text.
+/// @param error_pos Where to store the offset within the text at which the
+///                  error was found, or NULL if it isn't wanted. Nothing is
+///                  stored if the text is valid.
+/// @returns SAMETHING_CORE_PARSE_ERROR_NONE if the text is valid, or what is
+///          wrong with it.
+enum samething_core_parse_error samething_core_header_parse(
+    struct samething_core_header *const header, const char *const text,
+    const size_t text_len, size_t *const error_pos);
+
+/// Formats a header as text, the way it's transmitted after the preamble.
+///
+/// No error checking takes place here; a header which
+/// samething_core_header_parse() accepted comes back as the same text.
+///
+/// @param header The header to format.
+/// @param text The buffer to store the text to, which must be able to hold
+///             SAMETHING_CORE_HEADER_TEXT_LEN_MAX + 1 characters. The text is
+///             terminated.
+/// @returns The length of the text.
+size_t samething_core_header_format(
+    const struct samething_core_header *const header, char *const text);
+
+/// Generates audio samples from a Specific Area Message Encoding (SAME) header
+/// into a buffer owned by the caller.
+///
+/// Any number of samples may be generated per call; successive calls continue
+/// where the last one left off.
+///
+/// To generate many whole messages, each into its own buffer, configure a
+/// generation context with each header in turn, and call this once per message
+/// with a buffer able to hold SAMETHING_CORE_MESSAGE_SAMPLES_NUM_MAX samples.
+/// Everything but the header bursts is copied out of the waveform tables shared
+/// by all generation contexts, so this is bound by the speed of memory. Where
+/// the messages needn't be contiguous, samething_core_segments_build() avoids
+/// the copies altogether.
+///
+/// @param ctx The generation context.
+/// @param dst The buffer to write the samples to.
+/// @param dst_size The maximum number of samples to write.
+/// @returns The number of samples written, which is less than dst_size only
+///          once the end of the message is reached, and 0 after that.
+size_t samething_core_samples_render(struct samething_core_gen_ctx *const ctx,
+                                     int16_t *const dst, const size_t dst_size);
+
 /// Generates audio samples from a Specific Area Message Encoding (SAME) header.
 ///
+/// Up to SAMETHING_CORE_SAMPLES_NUM_MAX samples are written to the sample
+/// buffer.
+///
 /// \param ctx The generation context.
-void samething_core_samples_gen(struct samething_core_gen_ctx *const ctx);
+/// \param sample_data The buffer to write the samples to, which must be able to
+///                    hold SAMETHING_CORE_SAMPLES_NUM_MAX samples.
+/// \returns The number of samples written, which is less than
+///          SAMETHING_CORE_SAMPLES_NUM_MAX only for the final chunk.
+size_t samething_core_samples_gen(struct samething_core_gen_ctx *const ctx,
+                                  int16_t *const sample_data);
+
+/// Fills one half of a double buffer which is drained by a DMA engine.
+///
+/// This is meant to be called from the interrupt raised when the DMA engine
+/// moves on to the other half. It takes time proportional to half_size: no
+/// sample takes more than a bounded amount of work, and at most
+/// SAMETHING_CORE_SEQ_PLAN_SIZE_MAX steps of the sequence plan are crossed per
+/// call. Nothing is locked or allocated, and no shared state is written, so
+/// distinct generation contexts may be filled from distinct interrupts. With
+/// SAMETHING_CORE_FAST_SINE or SAMETHING_CORE_FIXED_POINT, nothing from libm is
+/// called either.
+///
+/// The generation context must have been initialized beforehand, outside of
+/// the interrupt, since that builds the shared tables. Once the end of the
+/// message is reached, the rest of the half is filled with silence so the DMA
+/// engine can keep running.
+///
+/// @param ctx The generation context.
+/// @param buffer The double buffer, which must be able to hold 2 * half_size
+///               samples.
+/// @param half_size The number of samples in each half of the double buffer.
+/// @param half The half to fill, 0 or 1.
+/// @returns The number of samples of the message written, which is less than
+///          half_size only once the end of the message is reached.
+size_t samething_core_half_render(struct samething_core_gen_ctx *const ctx,
+                                  int16_t *const buffer,
+                                  const size_t half_size,
+                                  const unsigned int half);
+
+#ifndef SAMETHING_CORE_TINY
+/// Describes an entire message as an ordered list of segments.
+///
+/// Each distinct segment is rendered only once: the header burst is rendered
+/// to the specified buffer, and every other segment points into the waveform
+/// tables shared by all generation contexts. Repeated segments point to the
+/// same samples. The segments remain valid for as long as the burst buffer
+/// does.
+///
+/// This must be called before any samples are generated from the generation
+/// context, and does not alter it. The generation context must have been
+/// configured with samething_core_ctx_init().
+///
+/// This isn't available with SAMETHING_CORE_TINY, which has no waveform tables.
+///
+/// @param ctx The generation context.
+/// @param burst The buffer to render the header burst to, which must be able to
+///              hold SAMETHING_CORE_HEADER_SAMPLES_NUM_MAX samples.
+/// @param segments The buffer to store the segments to, which must be able to
+///                 hold SAMETHING_CORE_SEGMENTS_NUM_MAX segments.
+/// @returns The number of segments stored.
+size_t samething_core_segments_build(
+    const struct samething_core_gen_ctx *const ctx, int16_t *const burst,
+    struct samething_core_segment *const segments);
+#endif  // SAMETHING_CORE_TINY
+
+/// Describes where each step of the sequence plan lies within a message,
+/// without generating anything.
+///
+/// @param ctx The generation context.
+/// @param spans The buffer to store the span of each step to, which must be
+///              able to hold as many spans as there are steps in the sequence
+///              plan (SAMETHING_CORE_SEQ_STATE_NUM for the standard one), or
+///              NULL if only the length of the message is wanted.
+/// @returns The total number of samples in the message.
+size_t samething_core_seq_spans_get(
+    const struct samething_core_gen_ctx *const ctx,
+    struct samething_core_seq_span *const spans);
+
+/// Positions a generation context at a sample within its message, so that the
+/// next samples generated start from there.
+///
+/// This works regardless of how far along generation is. Seeking to or past
+/// the end of the message finishes it.
+///
+/// @param ctx The generation context.
+/// @param sample_offset The sample to continue generating from.
+void samething_core_seek(struct samething_core_gen_ctx *const ctx,
+                         const size_t sample_offset);
+
+/// Positions a cursor at a sample within the message of a generation context.
+///
+/// Seeking to or past the end of the message puts the cursor at its end.
+///
+/// @param ctx The generation context holding the message, which isn't altered.
+/// @param cursor The cursor to position.
+/// @param sample_offset The sample to position the cursor at.
+void samething_core_cursor_seek(const struct samething_core_gen_ctx *const ctx,
+                                struct samething_core_cursor *const cursor,
+                                const size_t sample_offset);
+
+/// Generates audio samples from the position of a cursor, and advances it.
+///
+/// The samples are exactly those samething_core_samples_gen would generate at
+/// the same position.
+///
+/// @param ctx The generation context holding the message, which isn't altered.
+/// @param cursor The cursor to generate from.
+/// @param dst The buffer to write the samples to.
+/// @param dst_size The maximum number of samples to write.
+/// @returns The number of samples written, which is less than dst_size only
+///          once the end of the message is reached.
+size_t samething_core_cursor_render(
+    const struct samething_core_gen_ctx *const ctx,
+    struct samething_core_cursor *const cursor, int16_t *const dst,
+    const size_t dst_size);
+
+/// Generates a range of audio samples from anywhere within a message.
+///
+/// This alters nothing but the buffer, so a message can be split into ranges
+/// which are generated concurrently from the same generation context, once it
+/// has been initialized.
+///
+/// @param ctx The generation context holding the message, which isn't altered.
+/// @param sample_offset The first sample of the range.
+/// @param dst The buffer to write the samples to.
+/// @param num_samples The number of samples in the range.
+/// @returns The number of samples written, which is less than num_samples only
+///          if the range goes past the end of the message.
+size_t samething_core_range_render(
+    const struct samething_core_gen_ctx *const ctx, const size_t sample_offset,
+    int16_t *const dst, const size_t num_samples);
+
+/// Fans out mono samples to interleaved frames, applying the gain of each
+/// channel.
+///
+/// Fanning out works from the front of the buffers, so \p src may overlap
+/// \p dst as long as it starts at least num_frames * (num_channels - 1)
+/// samples into it.
+///
+/// @param map The channels to fan out to.
+/// @param dst The buffer to write the frames to, which must be able to hold
+///            num_frames * num_channels samples.
+/// @param src The samples to fan out.
+/// @param num_frames The number of samples to fan out.
+void samething_core_channels_interleave(
+    const struct samething_core_channel_map *const map, int16_t *const dst,
+    const int16_t *const src, const size_t num_frames);
+
+/// Generates interleaved frames of audio from a Specific Area Message Encoding
+/// (SAME) header into a buffer owned by the caller.
+///
+/// This behaves like samething_core_samples_render(), except that each sample
+/// is fanned out to a frame of one or more channels in place, without an
+/// intermediate buffer.
+///
+/// @param ctx The generation context.
+/// @param map The channels to fan out to.
+/// @param dst The buffer to write the frames to.
+/// @param dst_frames The maximum number of frames to write; the buffer must be
+///                   able to hold dst_frames * num_channels samples.
+/// @returns The number of frames written, which is less than dst_frames only
+///          once the end of the message is reached, and 0 after that.
+size_t samething_core_frames_render(
+    struct samething_core_gen_ctx *const ctx,
+    const struct samething_core_channel_map *const map, int16_t *const dst,
+    const size_t dst_frames);
+
+/// Sets up a pool of generation contexts, all of which start out free.
+///
+/// @param pool The pool to set up.
+/// @param ctxs The generation contexts to hand out, which must outlive the
+///             pool.
+/// @param num_ctxs The number of generation contexts.
+void samething_core_ctx_pool_init(struct samething_core_ctx_pool *const pool,
+                                  struct samething_core_gen_ctx *const ctxs,
+                                  const size_t num_ctxs);
+
+/// Takes a free generation context from a pool, and configures it to generate
+/// the specified header.
+///
+/// Only the state of the generation context is reset; nothing else is cleared.
+///
+/// @param pool The pool to take the generation context from.
+/// @param header The header data to generate a SAME header from.
+/// @param sample_rate The sample rate to generate at, or 0 to configure the
+///                    generation context with samething_core_ctx_init().
+/// @returns The generation context, or NULL if the pool has none free.
+struct samething_core_gen_ctx *samething_core_ctx_pool_acquire(
+    struct samething_core_ctx_pool *const pool,
+    const struct samething_core_header *const header,
+    const unsigned int sample_rate);
+
+/// Returns a generation context to the pool it was taken from.
+///
+/// @param pool The pool the generation context was taken from.
+/// @param ctx The generation context, which must not be used again until it is
+///            taken from the pool again.
+void samething_core_ctx_pool_release(struct samething_core_ctx_pool *const pool,
+                                     struct samething_core_gen_ctx *const ctx);
 
 #ifdef __cplusplus
 }
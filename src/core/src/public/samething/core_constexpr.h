@@ -0,0 +1,459 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file core_constexpr.h
+ * Renders messages at compile time.
+ *
+ * This is a header-only C++17 layer over the core for messages whose header is
+ * known at compile time, such as the weekly test of a station. The whole
+ * message becomes a constant array, which the compiler places in read-only
+ * data (or flash), so it costs nothing to generate at runtime:
+ *
+ *     constexpr samething_core_header kWeeklyTest = {...};
+ *     constexpr auto& kSamples = samething::core::kMessage<kWeeklyTest>;
+ *
+ * The samples are exactly those which samething_core_ctx_init() followed by
+ * samething_core_samples_render() would generate with
+ * SAMETHING_CORE_FIXED_POINT (or SAMETHING_CORE_TINY), including with
+ * SAMETHING_CORE_AFSK_CONTINUOUS_PHASE. The floating point tone kernels differ
+ * from the fixed point one by no more than 2 per sample, so the samples are
+ * that close to what any other build generates.
+ *
+ * A message holds several hundred thousand samples, which can take more
+ * evaluation steps than a compiler allows by default, in particular with
+ * SAMETHING_CORE_AFSK_CONTINUOUS_PHASE, where every bit is rendered on its own.
+ * Raising the limit to 2^27 (-fconstexpr-ops-limit for GCC, -fconstexpr-steps
+ * for Clang) is enough for a message with a two second attention signal.
+ */
+
+#ifndef SAMETHING_CORE_CONSTEXPR_H
+#define SAMETHING_CORE_CONSTEXPR_H
+
+#pragma once
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L)
+#error "samething/core_constexpr.h requires C++17 or later"
+#endif  // !defined(__cplusplus) || (__cplusplus < 201703L)
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "samething/core.h"
+#include "samething/core_sine_table.h"
+
+namespace samething::core {
+namespace internal {
+
+/// A quarter cycle of a sine wave in Q15, plus the peak. This is the table the
+/// fixed-point tone kernel of the core interpolates between.
+inline constexpr std::int16_t kSineTable[257] = SAMETHING_CORE_SINE_TABLE_INIT;
+
+/// The sample rate, in Hz.
+inline constexpr float kSampleRate =
+    static_cast<float>(SAMETHING_CORE_SAMPLE_RATE);
+
+/// The per-sample phase increment of the AFSK oscillator, indexed by the value
+/// of the bit being generated (0 for space, 1 for mark). This is computed the
+/// same way as by the core.
+inline constexpr std::uint32_t kAfskPhaseInc[2] = {
+    static_cast<std::uint32_t>((SAMETHING_CORE_AFSK_SPACE_FREQ / kSampleRate) *
+                               4294967296.0F),
+    static_cast<std::uint32_t>((SAMETHING_CORE_AFSK_MARK_FREQ / kSampleRate) *
+                               4294967296.0F)};
+
+/// The frequencies of the attention signal, in Hz.
+inline constexpr std::uint32_t kAttnSigFreqs[2] = {
+    static_cast<std::uint32_t>(SAMETHING_CORE_ATTN_SIG_FREQ_FIRST),
+    static_cast<std::uint32_t>(SAMETHING_CORE_ATTN_SIG_FREQ_SECOND)};
+
+/// The frequency of the NOAA Weather Radio (NWR) attention signal, in Hz.
+inline constexpr std::uint32_t kAttnSigNwrFreq =
+    static_cast<std::uint32_t>(SAMETHING_CORE_ATTN_SIG_NWR_FREQ);
+
+/// The gain of a tone at full scale, in Q15.
+inline constexpr std::int32_t kToneGainFull = INT32_C(1) << 15;
+
+/// Defines a tone for ToneRender() to render.
+struct Tone {
+  /// The phase of the first sample, where 2^32 is one full cycle.
+  std::uint32_t phase;
+
+  /// The per-sample phase increment, where 2^32 is one full cycle.
+  std::uint32_t phase_inc;
+
+  /// The amplitude of the tone, in Q15.
+  std::int32_t gain;
+};
+
+/// Computes the sine of a phase in Q15, exactly as the fixed point tone kernel
+/// does.
+///
+/// @param phase The phase, where 2^32 is one full cycle.
+/// @returns The sine of the phase.
+constexpr std::int32_t SineQ15(const std::uint32_t phase) noexcept {
+  const std::uint32_t quarter =
+      ((phase & (UINT32_C(1) << 30)) ? ~phase : phase) & 0x3FFFFFFFU;
+
+  const std::uint32_t index = quarter >> 22;
+  const std::int32_t frac = static_cast<std::int32_t>((quarter >> 7) & 0x7FFFU);
+
+  const std::int32_t a = kSineTable[index];
+  const std::int32_t b = kSineTable[index + 1];
+  const std::int32_t sine = a + ((((b - a) * frac) + (1 << 14)) >> 15);
+
+  return (phase & (UINT32_C(1) << 31)) ? -sine : sine;
+}
+
+/// Renders the sum of one or more tones, exactly as the fixed point tone kernel
+/// does.
+///
+/// @param dst The buffer to render the samples to.
+/// @param num_samples The number of samples to render.
+/// @param tones The tones to render.
+/// @param num_tones The number of tones to render.
+constexpr void ToneRender(std::int16_t *const dst,
+                          const std::size_t num_samples,
+                          const Tone *const tones,
+                          const std::size_t num_tones) noexcept {
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    std::int32_t acc = 0;
+
+    for (std::size_t tone = 0; tone < num_tones; ++tone) {
+      const std::uint32_t phase =
+          tones[tone].phase +
+          (tones[tone].phase_inc * static_cast<std::uint32_t>(i));
+
+      acc += (SineQ15(phase) * tones[tone].gain) >> 8;
+    }
+
+    const std::int32_t sample = (acc + (1 << 6)) >> 7;
+
+    if (sample > INT16_MAX) {
+      dst[i] = INT16_MAX;
+    } else if (sample < INT16_MIN) {
+      dst[i] = INT16_MIN;
+    } else {
+      dst[i] = static_cast<std::int16_t>(sample);
+    }
+  }
+}
+
+/// Defines the data an AFSK burst is generated from.
+struct BurstData {
+  /// The characters of the burst.
+  std::uint8_t data[SAMETHING_CORE_HEADER_SIZE_MAX] = {};
+
+  /// The number of characters in the burst.
+  std::size_t size = 0;
+
+  /// Appends a character to the burst.
+  constexpr void Append(const char c) noexcept {
+    data[size++] = static_cast<std::uint8_t>(c);
+  }
+
+  /// Appends a field to the burst, followed by a dash.
+  constexpr void FieldAdd(const char *const field,
+                          const std::size_t field_len) noexcept {
+    for (std::size_t i = 0; i < field_len; ++i) {
+      Append(field[i]);
+    }
+    Append('-');
+  }
+};
+
+/// Builds the header burst of a message, exactly as samething_core_ctx_init()
+/// does.
+///
+/// @param header The header data to build the burst from.
+/// @returns The header burst.
+constexpr BurstData HeaderBuild(const samething_core_header &header) noexcept {
+  BurstData burst;
+
+  for (std::size_t i = 0; i < SAMETHING_CORE_PREAMBLE_NUM; ++i) {
+    burst.Append(static_cast<char>(SAMETHING_CORE_PREAMBLE));
+  }
+  burst.FieldAdd("ZCZC", SAMETHING_CORE_ASCII_ID_LEN);
+  burst.FieldAdd(header.originator_code, SAMETHING_CORE_ORIGINATOR_CODE_LEN);
+  burst.FieldAdd(header.event_code, SAMETHING_CORE_EVENT_CODE_LEN);
+
+  constexpr const char *kEndMarker = SAMETHING_CORE_LOCATION_CODE_END_MARKER;
+
+  for (std::size_t i = 0; i < SAMETHING_CORE_LOCATION_CODES_NUM_MAX; ++i) {
+    bool end = true;
+
+    for (std::size_t c = 0; c < SAMETHING_CORE_LOCATION_CODE_LEN; ++c) {
+      end = end && (header.location_codes[i][c] == kEndMarker[c]);
+    }
+
+    if (end) {
+      break;
+    }
+    burst.FieldAdd(header.location_codes[i], SAMETHING_CORE_LOCATION_CODE_LEN);
+  }
+  burst.data[burst.size - 1] = '+';
+
+  burst.FieldAdd(header.valid_time_period,
+                 SAMETHING_CORE_VALID_TIME_PERIOD_LEN);
+  burst.FieldAdd(header.originator_time, SAMETHING_CORE_ORIGINATOR_TIME_LEN);
+  burst.FieldAdd(header.callsign, SAMETHING_CORE_CALLSIGN_LEN);
+
+  return burst;
+}
+
+/// Builds the End of Message (EOM) burst.
+///
+/// @returns The EOM burst.
+constexpr BurstData EomBuild() noexcept {
+  BurstData burst;
+
+  for (std::size_t i = 0; i < SAMETHING_CORE_PREAMBLE_NUM; ++i) {
+    burst.Append(static_cast<char>(SAMETHING_CORE_PREAMBLE));
+  }
+
+  while (burst.size < SAMETHING_CORE_EOM_HEADER_SIZE) {
+    burst.Append('N');
+  }
+  return burst;
+}
+
+/// Computes the total number of samples in a sequence state of a message.
+///
+/// @param state The sequence state to compute the number of samples of.
+/// @param header_size The number of characters in the header burst.
+/// @param attn_sig_duration The duration of the attention signal, in seconds.
+/// @returns The number of samples in the sequence state.
+constexpr std::size_t SeqStateSamplesNum(
+    const samething_core_seq_state state, const std::size_t header_size,
+    const unsigned int attn_sig_duration) noexcept {
+  constexpr std::size_t kCharSamples =
+      SAMETHING_CORE_AFSK_BITS_PER_CHAR * SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+
+  switch (state) {
+    case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST:
+    case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_SECOND:
+    case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_THIRD:
+      return header_size * kCharSamples;
+
+    case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_FIRST:
+    case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_SECOND:
+    case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_THIRD:
+      return SAMETHING_CORE_EOM_HEADER_SIZE * kCharSamples;
+
+    case SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL:
+      return std::size_t{attn_sig_duration} * SAMETHING_CORE_SAMPLE_RATE;
+
+    default:
+      return std::size_t{SAMETHING_CORE_SILENCE_DURATION} *
+             SAMETHING_CORE_SAMPLE_RATE;
+  }
+}
+
+/// Renders an AFSK burst.
+///
+/// Unless the phase is carried across bits, there are only two distinct bit
+/// waveforms; they are rendered once, and every bit is copied from them.
+///
+/// @param dst The buffer to render the samples to.
+/// @param burst The data to generate the burst from.
+/// @returns The number of samples rendered.
+constexpr std::size_t AfskRender(std::int16_t *const dst,
+                                 const BurstData &burst) noexcept {
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  std::uint32_t phase = 0;
+#else
+  std::int16_t waves[2][SAMETHING_CORE_AFSK_SAMPLES_PER_BIT] = {};
+
+  for (unsigned int bit = 0; bit < 2; ++bit) {
+    const Tone tone = {0, kAfskPhaseInc[bit], kToneGainFull};
+    ToneRender(waves[bit], SAMETHING_CORE_AFSK_SAMPLES_PER_BIT, &tone, 1);
+  }
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+
+  std::size_t pos = 0;
+
+  for (std::size_t byte = 0; byte < burst.size; ++byte) {
+    for (unsigned int bit_pos = 0; bit_pos < SAMETHING_CORE_AFSK_BITS_PER_CHAR;
+         ++bit_pos) {
+      const unsigned int bit = (burst.data[byte] >> bit_pos) & 1U;
+
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+      const Tone tone = {phase, kAfskPhaseInc[bit], kToneGainFull};
+
+      ToneRender(&dst[pos], SAMETHING_CORE_AFSK_SAMPLES_PER_BIT, &tone, 1);
+      phase += kAfskPhaseInc[bit] * SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+#else
+      for (std::size_t i = 0; i < SAMETHING_CORE_AFSK_SAMPLES_PER_BIT; ++i) {
+        dst[pos + i] = waves[bit][i];
+      }
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+      pos += SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+    }
+  }
+  return pos;
+}
+
+/// Renders the attention signal.
+///
+/// The oscillators are anchored every SAMETHING_CORE_TONE_RENDER_MAX samples,
+/// as the core anchors them, and every second is the same as the first. The
+/// NOAA Weather Radio (NWR) attention signal is instead a single cycle of its
+/// tone, repeated.
+///
+/// @param dst The buffer to render the samples to.
+/// @param duration The duration of the attention signal, in seconds.
+/// @param type Which attention signal to render.
+/// @returns The number of samples rendered.
+constexpr std::size_t AttnSigRender(
+    std::int16_t *const dst, const unsigned int duration,
+    const samething_core_attn_sig_type type) noexcept {
+  constexpr std::uint64_t kRate = SAMETHING_CORE_SAMPLE_RATE;
+
+  if (duration == 0) {
+    return 0;
+  }
+
+  if (type == SAMETHING_CORE_ATTN_SIG_TYPE_NWR) {
+    constexpr std::size_t kPeriod = kRate / kAttnSigNwrFreq;
+
+    const Tone tone = {
+        0, static_cast<std::uint32_t>((std::uint64_t{kAttnSigNwrFreq} << 32U) /
+                                      kRate),
+        kToneGainFull};
+    ToneRender(dst, kPeriod, &tone, 1);
+
+    for (std::size_t i = kPeriod; i < duration * kRate; ++i) {
+      dst[i] = dst[i - kPeriod];
+    }
+    return duration * kRate;
+  }
+
+  for (std::uint64_t pos = 0; pos < kRate;
+       pos += SAMETHING_CORE_TONE_RENDER_MAX) {
+    const std::uint64_t num_samples =
+        ((kRate - pos) < SAMETHING_CORE_TONE_RENDER_MAX)
+            ? (kRate - pos)
+            : SAMETHING_CORE_TONE_RENDER_MAX;
+
+    Tone tones[2] = {};
+
+    for (std::size_t i = 0; i < 2; ++i) {
+      const std::uint64_t cycles = (kAttnSigFreqs[i] * pos) % kRate;
+
+      tones[i].phase = static_cast<std::uint32_t>((cycles << 32U) / kRate);
+      tones[i].phase_inc = static_cast<std::uint32_t>(
+          (std::uint64_t{kAttnSigFreqs[i]} << 32U) / kRate);
+      tones[i].gain = kToneGainFull / 2;
+    }
+    ToneRender(&dst[pos], num_samples, tones, 2);
+  }
+
+  for (std::size_t second = 1; second < duration; ++second) {
+    for (std::size_t i = 0; i < kRate; ++i) {
+      dst[(second * kRate) + i] = dst[i];
+    }
+  }
+  return duration * kRate;
+}
+
+}  // namespace internal
+
+/// Computes the number of samples in the message generated from a header.
+///
+/// @param header The header data to generate a SAME header from.
+/// @returns The number of samples in the message.
+constexpr std::size_t MessageSamplesNum(
+    const samething_core_header &header) noexcept {
+  const std::size_t header_size = internal::HeaderBuild(header).size;
+
+  std::size_t num_samples = 0;
+
+  for (int state = 0; state < SAMETHING_CORE_SEQ_STATE_NUM; ++state) {
+    num_samples += internal::SeqStateSamplesNum(
+        static_cast<samething_core_seq_state>(state), header_size,
+        header.attn_sig_duration);
+  }
+  return num_samples;
+}
+
+/// Renders the message generated from a header in its entirety.
+///
+/// @tparam kHeader The header data to generate a SAME header from.
+/// @returns The samples of the message.
+template <const samething_core_header &kHeader>
+constexpr std::array<std::int16_t, MessageSamplesNum(kHeader)>
+MessageRender() noexcept {
+  static_assert(kHeader.attn_sig_duration <=
+                    SAMETHING_CORE_ATTN_SIG_DURATION_MAX,
+                "The attention signal is too long");
+
+  const internal::BurstData header = internal::HeaderBuild(kHeader);
+  const internal::BurstData eom = internal::EomBuild();
+
+  // Silence is left as it is initialized.
+  std::array<std::int16_t, MessageSamplesNum(kHeader)> samples = {};
+  std::size_t pos = 0;
+
+  for (int state = 0; state < SAMETHING_CORE_SEQ_STATE_NUM; ++state) {
+    const auto seq_state = static_cast<samething_core_seq_state>(state);
+
+    switch (seq_state) {
+      case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST:
+      case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_SECOND:
+      case SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_THIRD:
+        pos += internal::AfskRender(&samples[pos], header);
+        break;
+
+      case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_FIRST:
+      case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_SECOND:
+      case SAMETHING_CORE_SEQ_STATE_AFSK_EOM_THIRD:
+        pos += internal::AfskRender(&samples[pos], eom);
+        break;
+
+      case SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL:
+        pos += internal::AttnSigRender(&samples[pos],
+                                       kHeader.attn_sig_duration,
+                                       kHeader.attn_sig_type);
+        break;
+
+      default:
+        pos += internal::SeqStateSamplesNum(seq_state, header.size,
+                                            kHeader.attn_sig_duration);
+        break;
+    }
+  }
+  return samples;
+}
+
+/// The message generated from a header, rendered at compile time.
+///
+/// Each instantiation is a single constant array, which may also be used to
+/// initialize a constinit variable with C++20.
+///
+/// @tparam kHeader The header data to generate a SAME header from.
+template <const samething_core_header &kHeader>
+inline constexpr std::array<std::int16_t, MessageSamplesNum(kHeader)>
+    kMessage = MessageRender<kHeader>();
+
+}  // namespace samething::core
+
+#endif  // SAMETHING_CORE_CONSTEXPR_H
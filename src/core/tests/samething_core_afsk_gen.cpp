@@ -20,6 +20,10 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
 #include "gtest/gtest.h"
 #include "samething/core.h"
 
@@ -31,4 +35,205 @@ extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
                                                          const int, void *) {
   std::abort();
 }
+
+TEST(samething_core_afsk_gen, AssertsWhenContextIsNULL) {
+  const std::uint8_t plan[] = {0x88};
+  int16_t dst[1];
+  EXPECT_DEATH(
+      { samething_core_afsk_gen(nullptr, plan, sizeof(plan), 0, dst, 1); },
+      ".*");
+}
+
+TEST(samething_core_afsk_gen, AssertsWhenPlanIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  int16_t dst[1];
+  EXPECT_DEATH(
+      { samething_core_afsk_gen(&ctx, nullptr, 1, 0, dst, 1); },
+      ".*");
+}
+
+TEST(samething_core_afsk_gen, AssertsWhenBurstIsEmpty) {
+  struct samething_core_gen_ctx ctx = {};
+  int16_t dst[1];
+  EXPECT_DEATH(
+      { samething_core_afsk_gen(&ctx, nullptr, 0, 0, dst, 1); },
+      ".*");
+}
+
+TEST(samething_core_afsk_gen, AssertsWhenDstIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  const std::uint8_t plan[] = {0x88};
+
+  EXPECT_DEATH(
+      { samething_core_afsk_gen(&ctx, plan, sizeof(plan), 0, nullptr, 1); },
+      ".*");
+}
+
+TEST(samething_core_afsk_gen, AssertsWhenNumSamplesIsZero) {
+  struct samething_core_gen_ctx ctx = {};
+  const std::uint8_t plan[] = {0x88};
+
+  int16_t dst[1];
+
+  EXPECT_DEATH(
+      { samething_core_afsk_gen(&ctx, plan, sizeof(plan), 0, dst, 0); }, ".*");
+}
 #endif  // NDEBUG
+
+class AFSKGenTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ctx = {};
+
+    const struct samething_core_header header = {
+        .location_codes = {SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+        .valid_time_period = "0015",
+        .originator_code = "ORG",
+        .event_code = "RWT",
+        .callsign = "XIPHIAS ",
+        .originator_time = "3939393",
+        .attn_sig_duration = 8,
+        .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+    samething_core_ctx_init(&ctx, &header);
+  }
+
+  /// Builds the bit plan of the specified data, less the part streamed out of
+  /// the ROM.
+  void PlanBuild(const std::uint8_t *const data, const std::size_t data_size,
+                 const std::size_t rom_size) noexcept {
+    plan_size = samething_core_afsk_plan_build(plan, &data[rom_size],
+                                               data_size - rom_size);
+  }
+
+  /// Generates an AFSK burst of the specified data in its entirety.
+  void Generate(const std::uint8_t *const data, const std::size_t data_size,
+                const std::size_t rom_size = 0) noexcept {
+    const std::size_t num_samples = data_size *
+                                    SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+                                    SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+    ASSERT_LE(num_samples, kSamplesNumMax);
+
+    PlanBuild(data, data_size, rom_size);
+
+    for (std::size_t pos = 0; pos < num_samples;) {
+      pos += samething_core_afsk_gen(&ctx, plan, plan_size, rom_size,
+                                     &sample_data[pos], num_samples - pos);
+    }
+  }
+
+  /// Enough samples for a burst of 8 bytes, regardless of the chunk size.
+  static constexpr size_t kSamplesNumMax =
+      8 * SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+      SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[kSamplesNumMax];
+  std::uint8_t plan[SAMETHING_CORE_AFSK_PLAN_SIZE_MAX];
+  std::size_t plan_size;
+};
+
+/// Checks to see if the oscillator tracks an ideal sine wave of the correct
+/// frequency for each bit to within a single quantization step.
+TEST_F(AFSKGenTest, MatchesReferenceSine) {
+  static constexpr std::uint8_t data[] = {SAMETHING_CORE_PREAMBLE, 'Z', 'C'};
+  Generate(data, sizeof(data));
+
+  double phase = 0.0;
+  std::size_t pos = 0;
+
+  for (const std::uint8_t byte : data) {
+    for (unsigned int bit = 0; bit < SAMETHING_CORE_AFSK_BITS_PER_CHAR; ++bit) {
+      const double freq = ((byte >> bit) & 1) ? SAMETHING_CORE_AFSK_MARK_FREQ
+                                              : SAMETHING_CORE_AFSK_SPACE_FREQ;
+      const double step =
+          2.0 * std::acos(-1.0) * freq / SAMETHING_CORE_SAMPLE_RATE;
+
+#ifndef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+      phase = 0.0;
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+
+      for (unsigned int i = 0; i < SAMETHING_CORE_AFSK_SAMPLES_PER_BIT; ++i) {
+        const double expected = std::sin(phase) * INT16_MAX;
+        EXPECT_NEAR(sample_data[pos], expected, 1.5) << "sample " << pos;
+
+        phase += step;
+        pos++;
+      }
+    }
+  }
+}
+
+/// Checks to see if a single call generates across run boundaries, stopping
+/// partway through a run if asked to.
+TEST_F(AFSKGenTest, SpansRunBoundaries) {
+  static constexpr std::uint8_t data[] = {0x00, 0x00};
+  PlanBuild(data, sizeof(data), 0);
+
+  const std::size_t run_samples =
+      SAMETHING_CORE_AFSK_RUN_BITS_MAX * SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+
+  EXPECT_EQ(samething_core_afsk_gen(&ctx, plan, plan_size, 0, sample_data,
+                                    run_samples + 10),
+            run_samples + 10);
+  EXPECT_EQ(ctx.cursor.afsk.run_pos, 1);
+  EXPECT_EQ(ctx.cursor.afsk.sample_num, 10);
+}
+
+/// Checks to see if a single call never generates past the end of the burst.
+TEST_F(AFSKGenTest, StopsAtEndOfBurst) {
+  static constexpr std::uint8_t data[] = {SAMETHING_CORE_PREAMBLE};
+  PlanBuild(data, sizeof(data), 0);
+
+  EXPECT_EQ(samething_core_afsk_gen(&ctx, plan, plan_size, 0, sample_data,
+                                    kSamplesNumMax),
+            SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+                SAMETHING_CORE_AFSK_SAMPLES_PER_BIT);
+  EXPECT_EQ(ctx.cursor.afsk.run_pos, 0);
+  EXPECT_EQ(ctx.cursor.afsk.sample_num, 0);
+}
+
+/// Checks to see if the AFSK state is cleared once the burst is complete, so
+/// the next burst starts from the beginning.
+TEST_F(AFSKGenTest, ClearsStateAfterBurst) {
+  static constexpr std::uint8_t data[] = {'N', 'N'};
+  Generate(data, sizeof(data));
+
+  EXPECT_EQ(ctx.cursor.afsk.rom_pos, 0);
+  EXPECT_EQ(ctx.cursor.afsk.run_pos, 0);
+  EXPECT_EQ(ctx.cursor.afsk.sample_num, 0);
+  EXPECT_EQ(ctx.cursor.afsk.phase, 0);
+}
+
+/// Checks to see if the part of a burst streamed out of the pre-rendered table
+/// is identical to what would have been synthesized, including the bits which
+/// follow it.
+TEST_F(AFSKGenTest, StreamsPreambleFromROM) {
+  static constexpr std::uint8_t data[] = {
+      SAMETHING_CORE_PREAMBLE, SAMETHING_CORE_PREAMBLE, SAMETHING_CORE_PREAMBLE,
+      'Z', 'C'};
+
+  Generate(data, sizeof(data));
+
+  int16_t expected[kSamplesNumMax];
+  std::memcpy(expected, sample_data, sizeof(expected));
+
+  // Resume partway through the ROM, and leave it partway through a chunk.
+  const std::size_t num_samples =
+      sizeof(data) * SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+      SAMETHING_CORE_AFSK_SAMPLES_PER_BIT;
+
+  PlanBuild(data, sizeof(data), 3);
+
+  std::size_t pos = 0;
+
+  for (const std::size_t run : {std::size_t{100}, num_samples - 100}) {
+    pos += samething_core_afsk_gen(&ctx, plan, plan_size, 3,
+                                   &sample_data[pos], run);
+  }
+  EXPECT_EQ(pos, num_samples);
+
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    EXPECT_EQ(sample_data[i], expected[i]) << "sample " << i;
+  }
+  EXPECT_EQ(ctx.cursor.afsk.rom_pos, 0);
+}
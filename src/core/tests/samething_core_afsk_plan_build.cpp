@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+TEST(samething_core_afsk_plan_build, AssertsWhenPlanIsNULL) {
+  const std::uint8_t data[] = {SAMETHING_CORE_PREAMBLE};
+
+  EXPECT_DEATH(
+      { samething_core_afsk_plan_build(nullptr, data, sizeof(data)); }, ".*");
+}
+#endif  // NDEBUG
+
+namespace {
+/// Builds the bit plan of the specified data.
+std::vector<std::uint8_t> PlanBuild(
+    const std::vector<std::uint8_t> &data) noexcept {
+  std::vector<std::uint8_t> plan(data.size() *
+                                 SAMETHING_CORE_AFSK_BITS_PER_CHAR);
+
+  plan.resize(
+      samething_core_afsk_plan_build(plan.data(), data.data(), data.size()));
+  return plan;
+}
+}  // namespace
+
+/// Checks to see if nothing is planned for no data.
+TEST(samething_core_afsk_plan_build, PlansNothingForNoData) {
+  EXPECT_TRUE(PlanBuild({}).empty());
+}
+
+/// Checks to see if bits are planned least significant bit first, with runs of
+/// identical bits merged.
+TEST(samething_core_afsk_plan_build, MergesIdenticalBits) {
+  // 0xAB is transmitted as 1, 1, 0, 1, 0, 1, 0, 1.
+  const std::vector<std::uint8_t> expected = {0x82, 0x01, 0x81, 0x01,
+                                              0x81, 0x01, 0x81};
+
+  EXPECT_EQ(PlanBuild({SAMETHING_CORE_PREAMBLE}), expected);
+}
+
+/// Checks to see if runs carry over from one byte to the next.
+TEST(samething_core_afsk_plan_build, MergesAcrossBytes) {
+  // 0x80 then 0x01 is transmitted as 7 zeroes, 2 ones, then 7 zeroes.
+  const std::vector<std::uint8_t> expected = {0x07, 0x82, 0x07};
+
+  EXPECT_EQ(PlanBuild({0x80, 0x01}), expected);
+}
+
+/// Checks to see if runs are split once they reach the maximum length.
+TEST(samething_core_afsk_plan_build, SplitsLongRuns) {
+  const std::vector<std::uint8_t> plan = PlanBuild({0xFF, 0xFF, 0xFF});
+
+  std::size_t bits = 0;
+
+  for (const std::uint8_t run : plan) {
+    EXPECT_EQ(run & 0x80, 0x80);
+    EXPECT_LE(run & 0x7F, SAMETHING_CORE_AFSK_RUN_BITS_MAX);
+    bits += run & 0x7F;
+  }
+  EXPECT_EQ(bits, 3 * SAMETHING_CORE_AFSK_BITS_PER_CHAR);
+  EXPECT_EQ(plan.size(), (bits + SAMETHING_CORE_AFSK_RUN_BITS_MAX - 1) /
+                             SAMETHING_CORE_AFSK_RUN_BITS_MAX);
+}
@@ -20,6 +20,10 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
 #include "gtest/gtest.h"
 #include "samething/core.h"
 
@@ -31,4 +35,157 @@ extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
                                                          const int, void *) {
   std::abort();
 }
+
+TEST(samething_core_attn_sig_gen, AssertsWhenContextIsNULL) {
+  int16_t dst[1];
+  EXPECT_DEATH({ samething_core_attn_sig_gen(nullptr, dst, 1); }, ".*");
+}
+
+TEST(samething_core_attn_sig_gen, AssertsWhenNumSamplesIsZero) {
+  struct samething_core_gen_ctx ctx = {};
+  int16_t dst[1];
+  EXPECT_DEATH({ samething_core_attn_sig_gen(&ctx, dst, 0); }, ".*");
+}
 #endif  // NDEBUG
+
+class AttnSigGenTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ctx = {};
+
+    const struct samething_core_header header = {
+        .location_codes = {SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+        .valid_time_period = "0015",
+        .originator_code = "ORG",
+        .event_code = "RWT",
+        .callsign = "XIPHIAS ",
+        .originator_time = "3939393",
+        .attn_sig_duration = 8,
+        .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+    samething_core_ctx_init(&ctx, &header);
+  }
+
+  /// Computes the ideal value of the attention signal at the specified sample.
+  static double Expected(const std::size_t sample_num) noexcept {
+    const double t =
+        static_cast<double>(sample_num) / SAMETHING_CORE_SAMPLE_RATE;
+    const double calc = 2.0 * std::acos(-1.0) * t;
+    const double first =
+        calc * static_cast<double>(SAMETHING_CORE_ATTN_SIG_FREQ_FIRST);
+    const double second =
+        calc * static_cast<double>(SAMETHING_CORE_ATTN_SIG_FREQ_SECOND);
+
+    return ((std::sin(first) / 2.0) + (std::sin(second) / 2.0)) * INT16_MAX;
+  }
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+};
+
+/// Checks to see if the attention signal tracks the ideal dual tone to within
+/// a single quantization step.
+TEST_F(AttnSigGenTest, MatchesReferenceSine) {
+  samething_core_attn_sig_gen(&ctx, sample_data,
+                              SAMETHING_CORE_SAMPLES_NUM_MAX);
+
+  for (std::size_t i = 0; i < SAMETHING_CORE_SAMPLES_NUM_MAX; ++i) {
+    EXPECT_NEAR(sample_data[i], Expected(i), 1.5) << "sample " << i;
+  }
+}
+
+/// Checks to see if the attention signal wraps around seamlessly once a full
+/// period of it has been generated.
+TEST_F(AttnSigGenTest, WrapsAroundAfterOnePeriod) {
+  std::size_t generated = 0;
+
+  while (generated < SAMETHING_CORE_SAMPLE_RATE - 2) {
+    std::size_t num_samples = SAMETHING_CORE_SAMPLE_RATE - 2 - generated;
+
+    if (num_samples > SAMETHING_CORE_SAMPLES_NUM_MAX) {
+      num_samples = SAMETHING_CORE_SAMPLES_NUM_MAX;
+    }
+    samething_core_attn_sig_gen(&ctx, sample_data, num_samples);
+    generated += num_samples;
+  }
+
+  // The last two samples of the period should be followed by the first two
+  // samples of the next one.
+  samething_core_attn_sig_gen(&ctx, sample_data, 4);
+  EXPECT_EQ(ctx.cursor.attn_sig_sample_num, 2);
+
+  for (std::size_t i = 0; i < 4; ++i) {
+    const std::size_t sample_num = SAMETHING_CORE_SAMPLE_RATE - 2 + i;
+    EXPECT_NEAR(sample_data[i], Expected(sample_num), 1.5)
+        << "sample " << sample_num;
+  }
+}
+
+class NwrAttnSigGenTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ctx = {};
+
+    const struct samething_core_header header = {
+        .location_codes = {SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+        .valid_time_period = "0015",
+        .originator_code = "WXR",
+        .event_code = "RWT",
+        .callsign = "KEC61/NW",
+        .originator_time = "3939393",
+        .attn_sig_duration = 8,
+        .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_NWR};
+    samething_core_ctx_init(&ctx, &header);
+  }
+
+  /// Computes the ideal value of the NWR attention signal at the specified
+  /// sample.
+  static double Expected(const std::size_t sample_num) noexcept {
+    const double t =
+        static_cast<double>(sample_num) / SAMETHING_CORE_SAMPLE_RATE;
+
+    return std::sin(2.0 * std::acos(-1.0) * t *
+                    static_cast<double>(SAMETHING_CORE_ATTN_SIG_NWR_FREQ)) *
+           INT16_MAX;
+  }
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+};
+
+/// Checks to see if the NWR attention signal tracks the ideal single tone to
+/// within a single quantization step.
+TEST_F(NwrAttnSigGenTest, MatchesReferenceSine) {
+  samething_core_attn_sig_gen(&ctx, sample_data,
+                              SAMETHING_CORE_SAMPLES_NUM_MAX);
+
+  for (std::size_t i = 0; i < SAMETHING_CORE_SAMPLES_NUM_MAX; ++i) {
+    EXPECT_NEAR(sample_data[i], Expected(i), 1.5) << "sample " << i;
+  }
+}
+
+/// Checks to see if the NWR attention signal repeats exactly with every cycle
+/// of its tone, including across the end of a period.
+TEST_F(NwrAttnSigGenTest, RepeatsEveryCycle) {
+  const std::size_t cycle = static_cast<std::size_t>(
+      SAMETHING_CORE_SAMPLE_RATE / SAMETHING_CORE_ATTN_SIG_NWR_FREQ);
+
+  ASSERT_EQ(cycle, 42U);
+
+  int16_t first_cycle[42];
+  samething_core_attn_sig_gen(&ctx, first_cycle, cycle);
+
+  std::size_t generated = cycle;
+
+  while (generated < (2 * SAMETHING_CORE_SAMPLE_RATE)) {
+    const std::size_t num_samples =
+        std::min<std::size_t>(1000, SAMETHING_CORE_SAMPLES_NUM_MAX);
+
+    samething_core_attn_sig_gen(&ctx, sample_data, num_samples);
+
+    for (std::size_t i = 0; i < num_samples; ++i) {
+      ASSERT_EQ(sample_data[i], first_cycle[(generated + i) % cycle])
+          << "sample " << (generated + i);
+    }
+    generated += num_samples;
+  }
+}
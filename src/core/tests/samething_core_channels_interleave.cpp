@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_channels_interleave() asserts when the
+/// channel map specified is NULL.
+TEST(samething_core_channels_interleave, AssertsWhenMapIsNULL) {
+  int16_t dst[1];
+  const int16_t src[1] = {};
+
+  EXPECT_DEATH(
+      { samething_core_channels_interleave(nullptr, dst, src, 1); }, ".*");
+}
+
+/// Checks to see if samething_core_channels_interleave() asserts when there
+/// are no channels.
+TEST(samething_core_channels_interleave, AssertsWhenNoChannels) {
+  struct samething_core_channel_map map = {};
+  int16_t dst[1];
+  const int16_t src[1] = {};
+
+  EXPECT_DEATH({ samething_core_channels_interleave(&map, dst, src, 1); },
+               ".*");
+}
+
+/// Checks to see if samething_core_channels_interleave() asserts when there
+/// are too many channels.
+TEST(samething_core_channels_interleave, AssertsWhenTooManyChannels) {
+  struct samething_core_channel_map map = {};
+  int16_t dst[1];
+  const int16_t src[1] = {};
+
+  map.num_channels = SAMETHING_CORE_CHANNELS_NUM_MAX + 1;
+  EXPECT_DEATH({ samething_core_channels_interleave(&map, dst, src, 1); },
+               ".*");
+}
+#endif  // NDEBUG
+
+namespace {
+
+/// Fans out samples one at a time, for reference.
+std::vector<int16_t> InterleaveReference(
+    const struct samething_core_channel_map &map,
+    const std::vector<int16_t> &src) {
+  std::vector<int16_t> dst;
+
+  for (const int16_t sample : src) {
+    for (unsigned int channel = 0; channel < map.num_channels; ++channel) {
+      const int32_t gain =
+          (map.mute_mask & (1U << channel)) ? 0 : map.gains[channel];
+      const int32_t out = std::clamp<int32_t>((sample * gain) >> 14, INT16_MIN,
+                                              INT16_MAX);
+
+      dst.push_back(static_cast<int16_t>(out));
+    }
+  }
+  return dst;
+}
+
+/// Returns a channel map with a different gain on every channel, including
+/// gains which saturate, negative gains and a muted channel.
+struct samething_core_channel_map ChannelMap(const unsigned int num_channels) {
+  struct samething_core_channel_map map = {};
+
+  static const int16_t kGains[SAMETHING_CORE_CHANNELS_NUM_MAX] = {
+      SAMETHING_CORE_CHANNEL_GAIN(1.0F),   SAMETHING_CORE_CHANNEL_GAIN(0.5F),
+      SAMETHING_CORE_CHANNEL_GAIN(1.99F),  SAMETHING_CORE_CHANNEL_GAIN(-1.0F),
+      SAMETHING_CORE_CHANNEL_GAIN(0.25F),  SAMETHING_CORE_CHANNEL_GAIN(-2.0F),
+      SAMETHING_CORE_CHANNEL_GAIN(0.707F), SAMETHING_CORE_CHANNEL_GAIN(1.5F)};
+
+  std::copy(std::begin(kGains), std::end(kGains), map.gains);
+  map.num_channels = num_channels;
+  map.mute_mask = (num_channels > 1) ? 0x02 : 0x00;
+  return map;
+}
+
+/// Returns samples spanning the whole range of int16_t.
+std::vector<int16_t> Samples(const size_t num_samples) {
+  std::vector<int16_t> samples(num_samples);
+
+  for (size_t i = 0; i < num_samples; ++i) {
+    samples[i] = static_cast<int16_t>((i * 7919U) + 32768U);
+  }
+  return samples;
+}
+
+}  // namespace
+
+/// Checks to see if unity gain leaves samples untouched.
+TEST(samething_core_channels_interleave, UnityGainIsExact) {
+  struct samething_core_channel_map map = {};
+
+  map.num_channels = 2;
+  map.gains[0] = SAMETHING_CORE_CHANNEL_GAIN(1.0F);
+  map.gains[1] = SAMETHING_CORE_CHANNEL_GAIN(1.0F);
+
+  const std::vector<int16_t> src = {INT16_MIN, -1, 0, 1, INT16_MAX};
+  std::vector<int16_t> dst(src.size() * 2);
+
+  samething_core_channels_interleave(&map, dst.data(), src.data(), src.size());
+
+  for (size_t i = 0; i < src.size(); ++i) {
+    EXPECT_EQ(dst[(i * 2) + 0], src[i]);
+    EXPECT_EQ(dst[(i * 2) + 1], src[i]);
+  }
+}
+
+/// Checks every channel count against the reference, with lengths which don't
+/// fill a whole number of vector blocks.
+TEST(samething_core_channels_interleave, MatchesReference) {
+  for (unsigned int num_channels = 1;
+       num_channels <= SAMETHING_CORE_CHANNELS_NUM_MAX; ++num_channels) {
+    const struct samething_core_channel_map map = ChannelMap(num_channels);
+
+    for (size_t num_frames = 0; num_frames <= 41; ++num_frames) {
+      const std::vector<int16_t> src = Samples(num_frames);
+      std::vector<int16_t> dst(num_frames * num_channels + 1, 0x5A5A);
+
+      samething_core_channels_interleave(&map, dst.data(), src.data(),
+                                         num_frames);
+
+      // Nothing past the last frame is touched.
+      EXPECT_EQ(dst.back(), 0x5A5A);
+      dst.pop_back();
+
+      ASSERT_EQ(dst, InterleaveReference(map, src))
+          << num_channels << " channels, " << num_frames << " frames";
+    }
+  }
+}
+
+/// Checks to see if fanning out from the end of the destination buffer matches
+/// fanning out from a separate buffer.
+TEST(samething_core_channels_interleave, InPlaceMatchesReference) {
+  for (unsigned int num_channels = 1;
+       num_channels <= SAMETHING_CORE_CHANNELS_NUM_MAX; ++num_channels) {
+    const struct samething_core_channel_map map = ChannelMap(num_channels);
+
+    for (size_t num_frames = 1; num_frames <= 41; ++num_frames) {
+      const std::vector<int16_t> src = Samples(num_frames);
+      std::vector<int16_t> dst(num_frames * num_channels);
+      int16_t *const mono = &dst[num_frames * (num_channels - 1)];
+
+      std::copy(src.begin(), src.end(), mono);
+      samething_core_channels_interleave(&map, dst.data(), mono, num_frames);
+
+      ASSERT_EQ(dst, InterleaveReference(map, src))
+          << num_channels << " channels, " << num_frames << " frames";
+    }
+  }
+}
@@ -0,0 +1,331 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+namespace {
+
+/// The End of Message (EOM) bursts on their own, as sent to end a message.
+const struct samething_core_seq_step EOM_ONLY_PLAN[] = {
+    {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+    {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+    {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+    {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+    {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+    {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000}};
+
+/// The header bursts on their own, as sent to retransmit a header.
+const struct samething_core_seq_step HEADER_ONLY_PLAN[] = {
+    {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+    {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+    {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+    {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+    {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+    {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000}};
+
+/// A single header burst and attention signal, with half a second of silence
+/// around the attention signal.
+const struct samething_core_seq_step SHORT_SILENCE_PLAN[] = {
+    {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+    {SAMETHING_CORE_SEQ_KIND_SILENCE, 500},
+    {SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL, 0},
+    {SAMETHING_CORE_SEQ_KIND_SILENCE, 500}};
+
+}  // namespace
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_ctx_plan_init() asserts when the sequence
+/// plan specified is NULL.
+TEST(samething_core_ctx_plan_init, AssertsWhenPlanIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  const struct samething_core_header header = {};
+
+  EXPECT_DEATH({ samething_core_ctx_plan_init(&ctx, &header, 0, nullptr, 1); },
+               ".*");
+}
+
+/// Checks to see if samething_core_ctx_plan_init() asserts when the sequence
+/// plan specified is empty.
+TEST(samething_core_ctx_plan_init, AssertsWhenPlanIsEmpty) {
+  struct samething_core_gen_ctx ctx = {};
+  const struct samething_core_header header = {};
+
+  EXPECT_DEATH(
+      { samething_core_ctx_plan_init(&ctx, &header, 0, EOM_ONLY_PLAN, 0); },
+      ".*");
+}
+
+/// Checks to see if samething_core_ctx_plan_init() asserts when the sequence
+/// plan specified has too many steps.
+TEST(samething_core_ctx_plan_init, AssertsWhenPlanIsTooLarge) {
+  struct samething_core_gen_ctx ctx = {};
+  const struct samething_core_header header = {};
+  struct samething_core_seq_step steps[SAMETHING_CORE_SEQ_PLAN_SIZE_MAX + 1];
+
+  for (auto &step : steps) {
+    step = {SAMETHING_CORE_SEQ_KIND_SILENCE, 1};
+  }
+
+  EXPECT_DEATH(
+      {
+        samething_core_ctx_plan_init(&ctx, &header, 0, steps,
+                                     SAMETHING_CORE_SEQ_PLAN_SIZE_MAX + 1);
+      },
+      ".*");
+}
+
+/// Checks to see if samething_core_ctx_plan_init() asserts when the sequence
+/// plan specified has too many header bursts.
+TEST(samething_core_ctx_plan_init, AssertsWhenTooManyBursts) {
+  struct samething_core_gen_ctx ctx = {};
+  const struct samething_core_header header = {};
+  struct samething_core_seq_step steps[SAMETHING_CORE_SEQ_BURSTS_NUM_MAX + 1];
+
+  for (auto &step : steps) {
+    step = {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0};
+  }
+
+  EXPECT_DEATH(
+      {
+        samething_core_ctx_plan_init(&ctx, &header, 0, steps,
+                                     SAMETHING_CORE_SEQ_BURSTS_NUM_MAX + 1);
+      },
+      ".*");
+}
+
+/// Checks to see if samething_core_ctx_plan_init() asserts when the sequence
+/// plan specified has more silence than the standard one.
+TEST(samething_core_ctx_plan_init, AssertsWhenTooMuchSilence) {
+  struct samething_core_gen_ctx ctx = {};
+  const struct samething_core_header header = {};
+  const struct samething_core_seq_step steps[] = {
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, SAMETHING_CORE_SEQ_SILENCE_MS_MAX},
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, 1}};
+
+  EXPECT_DEATH({ samething_core_ctx_plan_init(&ctx, &header, 0, steps, 2); },
+               ".*");
+}
+
+/// Checks to see if samething_core_ctx_plan_init() asserts when the sample
+/// rate specified isn't supported.
+TEST(samething_core_ctx_plan_init, AssertsWhenSampleRateIsUnsupported) {
+  struct samething_core_gen_ctx ctx = {};
+  const struct samething_core_header header = {};
+
+  EXPECT_DEATH(
+      {
+        samething_core_ctx_plan_init(&ctx, &header, 12345, EOM_ONLY_PLAN,
+                                     std::size(EOM_ONLY_PLAN));
+      },
+      ".*");
+}
+#endif  // NDEBUG
+
+class CtxPlanInitTest : public ::testing::TestWithParam<unsigned int> {
+ protected:
+  void SetUp() override {
+    ref_ctx = {};
+
+    if (GetParam() == 0) {
+      samething_core_ctx_init(&ref_ctx, &header);
+    } else {
+      samething_core_ctx_rate_init(&ref_ctx, &header, GetParam());
+    }
+
+    ref_samples = Generate(&ref_ctx);
+    samething_core_seq_spans_get(&ref_ctx, ref_spans);
+  }
+
+  /// Generates the whole message of a generation context.
+  std::vector<int16_t> Generate(struct samething_core_gen_ctx *const c) {
+    std::vector<int16_t> samples;
+
+    while (c->cursor.seq_state != c->seq_plan_size) {
+      const size_t num_samples = samething_core_samples_gen(c, sample_data);
+      samples.insert(samples.end(), sample_data, &sample_data[num_samples]);
+    }
+    return samples;
+  }
+
+  /// Configures ctx with a sequence plan and generates the whole message.
+  template <size_t N>
+  std::vector<int16_t> Generate(
+      const struct samething_core_seq_step (&steps)[N]) {
+    ctx = {};
+    samething_core_ctx_plan_init(&ctx, &header, GetParam(), steps, N);
+    return Generate(&ctx);
+  }
+
+  /// Returns the samples of the reference message from one sequence state to
+  /// the end of another.
+  std::vector<int16_t> RefRange(const enum samething_core_seq_state first,
+                                const enum samething_core_seq_state last) {
+    const size_t start = ref_spans[first].start;
+    const size_t end = ref_spans[last].start + ref_spans[last].num_samples;
+
+    return {ref_samples.begin() + static_cast<std::ptrdiff_t>(start),
+            ref_samples.begin() + static_cast<std::ptrdiff_t>(end)};
+  }
+
+  /// Returns the number of samples in a second.
+  size_t SampleRate() const noexcept {
+    return (GetParam() != 0) ? GetParam() : SAMETHING_CORE_SAMPLE_RATE;
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ref_ctx;
+  struct samething_core_gen_ctx ctx;
+  struct samething_core_seq_span ref_spans[SAMETHING_CORE_SEQ_STATE_NUM];
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  std::vector<int16_t> ref_samples;
+};
+
+/// Checks that an End of Message (EOM) on its own is the end of the standard
+/// message.
+TEST_P(CtxPlanInitTest, EomOnlyMatchesStandard) {
+  EXPECT_EQ(Generate(EOM_ONLY_PLAN),
+            RefRange(SAMETHING_CORE_SEQ_STATE_AFSK_EOM_FIRST,
+                     SAMETHING_CORE_SEQ_STATE_SILENCE_SEVENTH));
+  EXPECT_EQ(ctx.seq_plan_size, std::size(EOM_ONLY_PLAN));
+}
+
+/// Checks that the header bursts on their own are the start of the standard
+/// message.
+TEST_P(CtxPlanInitTest, HeaderOnlyMatchesStandard) {
+  EXPECT_EQ(Generate(HEADER_ONLY_PLAN),
+            RefRange(SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST,
+                     SAMETHING_CORE_SEQ_STATE_SILENCE_THIRD));
+}
+
+/// Checks that silence lasts as long as the plan says, and that the other steps
+/// are unchanged by it.
+TEST_P(CtxPlanInitTest, SilenceLengthIsCustom) {
+  const std::vector<int16_t> samples = Generate(SHORT_SILENCE_PLAN);
+
+  struct samething_core_seq_span spans[std::size(SHORT_SILENCE_PLAN)];
+
+  EXPECT_EQ(samething_core_seq_spans_get(&ctx, spans), samples.size());
+  EXPECT_EQ(spans[1].num_samples, SampleRate() / 2);
+  EXPECT_EQ(spans[3].num_samples, SampleRate() / 2);
+
+  for (const size_t step : {size_t{1}, size_t{3}}) {
+    for (size_t i = 0; i < spans[step].num_samples; ++i) {
+      ASSERT_EQ(samples[spans[step].start + i], 0);
+    }
+  }
+
+  const std::vector<int16_t> burst =
+      RefRange(SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST,
+               SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST);
+  const std::vector<int16_t> attn_sig =
+      RefRange(SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL,
+               SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL);
+
+  EXPECT_EQ(std::vector<int16_t>(samples.begin(),
+                                 samples.begin() + spans[1].start),
+            burst);
+  EXPECT_EQ(std::vector<int16_t>(samples.begin() + spans[2].start,
+                                 samples.begin() + spans[3].start),
+            attn_sig);
+}
+
+/// Checks that the samples of a custom plan can be rendered from anywhere
+/// within the message.
+TEST_P(CtxPlanInitTest, RangesMatch) {
+  const std::vector<int16_t> samples = Generate(SHORT_SILENCE_PLAN);
+
+  std::vector<int16_t> actual(samples.size());
+  const size_t range = 7919;
+
+  for (size_t start = 0; start < samples.size(); start += range) {
+    samething_core_range_render(&ctx, start, &actual[start],
+                                std::min(range, samples.size() - start));
+  }
+  EXPECT_EQ(actual, samples);
+}
+
+/// Checks that the standard plan generates exactly what the standard
+/// configuration functions do.
+TEST_P(CtxPlanInitTest, StandardPlanMatches) {
+  static const struct samething_core_seq_step STANDARD_PLAN[] = {
+      {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+      {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+      {SAMETHING_CORE_SEQ_KIND_AFSK_HEADER, 0},
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+      {SAMETHING_CORE_SEQ_KIND_ATTENTION_SIGNAL, 0},
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+      {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+      {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000},
+      {SAMETHING_CORE_SEQ_KIND_AFSK_EOM, 0},
+      {SAMETHING_CORE_SEQ_KIND_SILENCE, 1000}};
+
+  EXPECT_EQ(Generate(STANDARD_PLAN), ref_samples);
+  EXPECT_EQ(ctx.seq_plan_size, SAMETHING_CORE_SEQ_STATE_NUM);
+}
+
+/// Checks that updating the header keeps the sequence plan.
+TEST_P(CtxPlanInitTest, HeaderUpdateKeepsPlan) {
+  Generate(EOM_ONLY_PLAN);
+
+  struct samething_core_header updated = header;
+  updated.event_code[0] = 'T';
+
+  struct samething_core_seq_span changed;
+  EXPECT_TRUE(samething_core_header_update(&ctx, &updated, &changed));
+  EXPECT_EQ(ctx.seq_plan_size, std::size(EOM_ONLY_PLAN));
+  EXPECT_EQ(Generate(&ctx),
+            RefRange(SAMETHING_CORE_SEQ_STATE_AFSK_EOM_FIRST,
+                     SAMETHING_CORE_SEQ_STATE_SILENCE_SEVENTH));
+}
+
+INSTANTIATE_TEST_SUITE_P(SampleRates, CtxPlanInitTest,
+                         ::testing::Values(0U, 8000U, 48000U));
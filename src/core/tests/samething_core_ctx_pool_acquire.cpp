@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_ctx_pool_acquire() asserts when the pool
+/// specified is NULL.
+TEST(samething_core_ctx_pool_acquire, AssertsWhenPoolIsNULL) {
+  struct samething_core_header header = {};
+  EXPECT_DEATH({ samething_core_ctx_pool_acquire(nullptr, &header, 0); },
+               ".*");
+}
+
+/// Checks to see if samething_core_ctx_pool_release() asserts when the
+/// generation context specified doesn't belong to the pool.
+TEST(samething_core_ctx_pool_acquire, ReleaseAssertsWhenContextIsForeign) {
+  static struct samething_core_gen_ctx ctxs[2];
+  static struct samething_core_gen_ctx foreign;
+  struct samething_core_ctx_pool pool;
+
+  samething_core_ctx_pool_init(&pool, ctxs, 2);
+  EXPECT_DEATH({ samething_core_ctx_pool_release(&pool, &foreign); }, ".*");
+}
+
+/// Checks to see if samething_core_ctx_pool_release() asserts when more
+/// generation contexts are returned than were taken.
+TEST(samething_core_ctx_pool_acquire, ReleaseAssertsWhenPoolIsFull) {
+  static struct samething_core_gen_ctx ctxs[2];
+  struct samething_core_ctx_pool pool;
+
+  samething_core_ctx_pool_init(&pool, ctxs, 2);
+  EXPECT_DEATH({ samething_core_ctx_pool_release(&pool, &ctxs[0]); }, ".*");
+}
+#endif  // NDEBUG
+
+class CtxPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // Nothing is expected of the contexts handed to the pool, so make them as
+    // unlike new ones as possible.
+    std::memset(ctxs, 0xA5, sizeof(ctxs));
+    samething_core_ctx_pool_init(&pool, ctxs, kNumCtxs);
+  }
+
+  /// Generates the rest of the message of a generation context.
+  static std::vector<int16_t> Generate(
+      struct samething_core_gen_ctx *const ctx) {
+    std::vector<int16_t> samples(SAMETHING_CORE_MESSAGE_SAMPLES_NUM_MAX);
+
+    samples.resize(samething_core_samples_render(ctx, samples.data(),
+                                                 samples.size()));
+    return samples;
+  }
+
+  /// Generates a message with a generation context which was never used.
+  static std::vector<int16_t> GenerateFresh(
+      const struct samething_core_header &header,
+      const unsigned int sample_rate) {
+    static struct samething_core_gen_ctx ctx;
+
+    ctx = {};
+
+    if (sample_rate != 0) {
+      samething_core_ctx_rate_init(&ctx, &header, sample_rate);
+    } else {
+      samething_core_ctx_init(&ctx, &header);
+    }
+    return Generate(&ctx);
+  }
+
+  static constexpr size_t kNumCtxs = 4;
+
+  const struct samething_core_header long_header = {
+      .location_codes = {"101010", "828282", "939393", "040404", "151515",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 9,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  const struct samething_core_header short_header = {
+      .location_codes = {"101010", SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "0015",
+      .originator_code = "WXR",
+      .event_code = "TOR",
+      .callsign = "KXYZ/NWS",
+      .originator_time = "1231200",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctxs[kNumCtxs];
+  struct samething_core_ctx_pool pool;
+};
+
+/// Checks that each generation context is handed out once until it is
+/// returned.
+TEST_F(CtxPoolTest, HandsOutEachContextOnce) {
+  std::set<struct samething_core_gen_ctx *> acquired;
+
+  for (size_t i = 0; i < kNumCtxs; ++i) {
+    struct samething_core_gen_ctx *const ctx =
+        samething_core_ctx_pool_acquire(&pool, &short_header, 0);
+
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_GE(ctx, &ctxs[0]);
+    EXPECT_LT(ctx, &ctxs[kNumCtxs]);
+    acquired.insert(ctx);
+  }
+  EXPECT_EQ(acquired.size(), kNumCtxs);
+  EXPECT_EQ(pool.num_free, 0U);
+  EXPECT_EQ(samething_core_ctx_pool_acquire(&pool, &short_header, 0), nullptr);
+
+  struct samething_core_gen_ctx *const released = *acquired.begin();
+
+  samething_core_ctx_pool_release(&pool, released);
+  EXPECT_EQ(samething_core_ctx_pool_acquire(&pool, &short_header, 0), released);
+}
+
+/// Checks that a reused generation context generates exactly what a new one
+/// does, whatever it was used for last and however far along it got.
+TEST_F(CtxPoolTest, ReusedContextsMatchNewOnes) {
+  const std::vector<int16_t> expected_long = GenerateFresh(long_header, 0);
+  const std::vector<int16_t> expected_short = GenerateFresh(short_header, 0);
+  const std::vector<int16_t> expected_rate =
+      GenerateFresh(short_header, 16000);
+
+  for (unsigned int round = 0; round < 3; ++round) {
+    // A longer message, left partway through its header burst.
+    struct samething_core_gen_ctx *ctx =
+        samething_core_ctx_pool_acquire(&pool, &long_header, 0);
+    ASSERT_NE(ctx, nullptr);
+
+    int16_t partial[1000];
+    samething_core_samples_render(ctx, partial, 1000);
+    samething_core_ctx_pool_release(&pool, ctx);
+
+    ctx = samething_core_ctx_pool_acquire(&pool, &short_header, 0);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(Generate(ctx), expected_short);
+    samething_core_ctx_pool_release(&pool, ctx);
+
+    ctx = samething_core_ctx_pool_acquire(&pool, &short_header, 16000);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(Generate(ctx), expected_rate);
+    samething_core_ctx_pool_release(&pool, ctx);
+
+    ctx = samething_core_ctx_pool_acquire(&pool, &long_header, 0);
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(Generate(ctx), expected_long);
+    samething_core_ctx_pool_release(&pool, ctx);
+  }
+  EXPECT_EQ(pool.num_free, kNumCtxs);
+}
+
+/// Checks that the state of a generation in progress is aligned to a cache
+/// line, and fits in one.
+TEST(samething_core_ctx_pool_acquire, StateFitsCacheLine) {
+  EXPECT_EQ(alignof(struct samething_core_cursor),
+            SAMETHING_CORE_CACHE_LINE_SIZE);
+  EXPECT_EQ(offsetof(struct samething_core_gen_ctx, cursor), 0U);
+#ifndef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  EXPECT_EQ(sizeof(struct samething_core_cursor),
+            SAMETHING_CORE_CACHE_LINE_SIZE);
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+}
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_ctx_rate_init() asserts when the sample
+/// rate specified isn't supported.
+TEST(samething_core_ctx_rate_init, AssertsWhenSampleRateIsUnsupported) {
+  struct samething_core_gen_ctx ctx = {};
+  const struct samething_core_header header = {};
+
+  EXPECT_DEATH({ samething_core_ctx_rate_init(&ctx, &header, 12345); },
+               ".*");
+}
+#endif  // NDEBUG
+
+class CtxRateInitTest : public ::testing::TestWithParam<unsigned int> {
+ protected:
+  void SetUp() override {
+    ctx = {};
+    samething_core_ctx_rate_init(&ctx, &header, GetParam());
+
+    while (ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
+      const size_t num_samples =
+          samething_core_samples_gen(&ctx, sample_data);
+
+      samples.insert(samples.end(), sample_data,
+                     &sample_data[num_samples]);
+    }
+  }
+
+  /// Computes the first sample of a bit of an AFSK burst.
+  size_t BitStart(const size_t bit_num) const noexcept {
+    // 520 5/6 bits per second.
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(bit_num) * 6U * GetParam() + 3124U) / 3125U);
+  }
+
+  /// Computes the power of a frequency within a range of samples.
+  double Power(const size_t start, const size_t end,
+               const double freq) const noexcept {
+    const double omega = 2.0 * M_PI * freq / GetParam();
+    double re = 0.0;
+    double im = 0.0;
+
+    for (size_t i = start; i < end; ++i) {
+      re += samples[i] * std::cos(omega * static_cast<double>(i));
+      im += samples[i] * std::sin(omega * static_cast<double>(i));
+    }
+    return (re * re) + (im * im);
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  std::vector<int16_t> samples;
+};
+
+/// Checks that the message is as long as it should be at the sample rate.
+TEST_P(CtxRateInitTest, MessageLength) {
+  const size_t burst_samples =
+      BitStart(ctx.header_size * SAMETHING_CORE_AFSK_BITS_PER_CHAR);
+  const size_t eom_samples = BitStart(SAMETHING_CORE_EOM_HEADER_SIZE *
+                                      SAMETHING_CORE_AFSK_BITS_PER_CHAR);
+
+  EXPECT_EQ(samples.size(),
+            (3 * burst_samples) + (3 * eom_samples) + ((7 + 8) * GetParam()));
+  EXPECT_EQ(samething_core_seq_spans_get(&ctx, nullptr), samples.size());
+}
+
+/// Checks that every bit of the header burst carries the right tone.
+TEST_P(CtxRateInitTest, HeaderBurstDecodes) {
+  for (size_t bit_num = 0;
+       bit_num < ctx.header_size * SAMETHING_CORE_AFSK_BITS_PER_CHAR;
+       ++bit_num) {
+    const bool mark = (ctx.header_data[bit_num / 8] >> (bit_num % 8)) & 1;
+    const size_t start = BitStart(bit_num);
+    const size_t end = BitStart(bit_num + 1);
+
+    const double mark_power = Power(start, end, 6250.0 / 3.0);
+    const double space_power = Power(start, end, 1562.5);
+
+    ASSERT_EQ(mark_power > space_power, mark) << "bit " << bit_num;
+  }
+}
+
+/// Checks that the samples can be generated from anywhere within the message.
+TEST_P(CtxRateInitTest, RangesMatch) {
+  std::vector<int16_t> actual(samples.size());
+  const size_t range = 12345;
+
+  for (size_t start = 0; start < samples.size(); start += range) {
+    samething_core_range_render(&ctx, start, &actual[start],
+                                std::min(range, samples.size() - start));
+  }
+  EXPECT_EQ(actual, samples);
+}
+
+/// Checks that the attention signal stays within full scale and repeats every
+/// second.
+TEST_P(CtxRateInitTest, AttentionSignalRepeats) {
+  struct samething_core_seq_span spans[SAMETHING_CORE_SEQ_STATE_NUM];
+  samething_core_seq_spans_get(&ctx, spans);
+
+  const size_t start = spans[SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL].start;
+
+  for (size_t i = 0; i < GetParam(); ++i) {
+    EXPECT_NEAR(samples[start + i], samples[start + GetParam() + i], 1);
+  }
+}
+
+/// Checks that the NOAA Weather Radio (NWR) attention signal is a single tone
+/// at the sample rate, and repeats every second.
+TEST_P(CtxRateInitTest, NwrAttentionSignalIsSingleTone) {
+  struct samething_core_header nwr_header = header;
+  nwr_header.attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_NWR;
+
+  ctx = {};
+  samething_core_ctx_rate_init(&ctx, &nwr_header, GetParam());
+
+  struct samething_core_seq_span spans[SAMETHING_CORE_SEQ_STATE_NUM];
+  samething_core_seq_spans_get(&ctx, spans);
+
+  const struct samething_core_seq_span &span =
+      spans[SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL];
+
+  samples.resize(span.start + span.num_samples);
+  samething_core_range_render(&ctx, span.start, &samples[span.start],
+                              span.num_samples);
+
+  const size_t start = span.start;
+  const size_t end = start + GetParam();
+  const double nwr_power = Power(start, end, SAMETHING_CORE_ATTN_SIG_NWR_FREQ);
+
+  EXPECT_GT(nwr_power,
+            100.0 * Power(start, end, SAMETHING_CORE_ATTN_SIG_FREQ_FIRST));
+  EXPECT_GT(nwr_power,
+            100.0 * Power(start, end, SAMETHING_CORE_ATTN_SIG_FREQ_SECOND));
+
+  for (size_t i = 0; i < GetParam(); ++i) {
+    EXPECT_NEAR(samples[start + i], samples[start + GetParam() + i], 1);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(SampleRates, CtxRateInitTest,
+                         ::testing::Values(8000U, 11025U, 16000U, 22050U,
+                                           44100U, 48000U));
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_cursor_render() asserts when the cursor
+/// specified is NULL.
+TEST(samething_core_cursor_render, AssertsWhenCursorIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  int16_t dst[1];
+
+  EXPECT_DEATH({ samething_core_cursor_render(&ctx, nullptr, dst, 1); },
+               ".*");
+}
+#endif  // NDEBUG
+
+class CursorRenderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ctx = {};
+    samething_core_ctx_init(&ctx, &header);
+
+    struct samething_core_gen_ctx ref_ctx = {};
+    samething_core_ctx_init(&ref_ctx, &header);
+
+    while (ref_ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
+      const size_t num_samples =
+          samething_core_samples_gen(&ref_ctx, sample_data);
+
+      expected.insert(expected.end(), sample_data,
+                      &sample_data[num_samples]);
+    }
+  }
+
+  /// Positions a cursor at the sample specified, streams the rest of the
+  /// message from it in chunks of the size specified, and checks that it
+  /// matches the reference stream.
+  void VerifyStream(const size_t sample_offset, const size_t chunk_size) {
+    struct samething_core_cursor cursor;
+    samething_core_cursor_seek(&ctx, &cursor, sample_offset);
+
+    std::vector<int16_t> chunk(chunk_size);
+    std::vector<int16_t> actual;
+
+    for (;;) {
+      const size_t num_samples = samething_core_cursor_render(
+          &ctx, &cursor, chunk.data(), chunk_size);
+
+      actual.insert(actual.end(), chunk.begin(), chunk.begin() + num_samples);
+
+      if (num_samples < chunk_size) {
+        break;
+      }
+    }
+    EXPECT_EQ(cursor.seq_state, SAMETHING_CORE_SEQ_STATE_NUM);
+    EXPECT_EQ(actual, std::vector<int16_t>(expected.begin() + sample_offset,
+                                           expected.end()));
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  std::vector<int16_t> expected;
+};
+
+TEST_F(CursorRenderTest, FromStart) { VerifyStream(0, 4096); }
+
+TEST_F(CursorRenderTest, FromWithinHeader) { VerifyStream(7777, 1000); }
+
+TEST_F(CursorRenderTest, FromWithinAttentionSignal) {
+  VerifyStream(300000, 333);
+}
+
+TEST_F(CursorRenderTest, FromLastSample) {
+  VerifyStream(expected.size() - 1, 64);
+}
@@ -102,6 +102,11 @@ TEST(samething_core_data, AFSKBitRateIsCorrect) {
   EXPECT_FLOAT_EQ(SAMETHING_CORE_AFSK_BIT_RATE, 520.83F);
 }
 
+TEST(samething_core_data, AFSKBitRateX100IsCorrect) {
+  EXPECT_FLOAT_EQ(SAMETHING_CORE_AFSK_BIT_RATE_X100 / 100.0F,
+                  SAMETHING_CORE_AFSK_BIT_RATE);
+}
+
 TEST(samething_core_data, AFSKMarkFreqIsCorrect) {
   EXPECT_FLOAT_EQ(SAMETHING_CORE_AFSK_MARK_FREQ, 2083.3F);
 }
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_frames_render() asserts when the generation
+/// context specified is NULL.
+TEST(samething_core_frames_render, AssertsWhenContextIsNULL) {
+  struct samething_core_channel_map map = {};
+  int16_t dst[1];
+
+  map.num_channels = 1;
+  EXPECT_DEATH({ samething_core_frames_render(nullptr, &map, dst, 1); },
+               ".*");
+}
+
+/// Checks to see if samething_core_frames_render() asserts when the channel
+/// map specified is NULL.
+TEST(samething_core_frames_render, AssertsWhenMapIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  int16_t dst[1];
+
+  EXPECT_DEATH({ samething_core_frames_render(&ctx, nullptr, dst, 1); },
+               ".*");
+}
+#endif  // NDEBUG
+
+class FramesRenderTest : public ::testing::TestWithParam<unsigned int> {
+ protected:
+  void SetUp() override {
+    ctx = {};
+    samething_core_ctx_init(&ctx, &header);
+
+    map = {};
+    map.num_channels = GetParam();
+
+    for (unsigned int channel = 0; channel < map.num_channels; ++channel) {
+      map.gains[channel] =
+          SAMETHING_CORE_CHANNEL_GAIN(1.0F / static_cast<float>(channel + 1));
+    }
+
+    // Mute the last channel, unless it's the only one.
+    if (map.num_channels > 1) {
+      map.mute_mask = static_cast<uint8_t>(1U << (map.num_channels - 1));
+    }
+
+    struct samething_core_gen_ctx ref_ctx = {};
+    samething_core_ctx_init(&ref_ctx, &header);
+
+    while (ref_ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
+      const size_t num_samples =
+          samething_core_samples_gen(&ref_ctx, sample_data);
+
+      mono.insert(mono.end(), sample_data,
+                  &sample_data[num_samples]);
+    }
+  }
+
+  /// Renders the whole message with buffers of the size specified, and checks
+  /// that each channel holds the reference stream with its gain applied.
+  void VerifyRender(const size_t dst_frames) {
+    const unsigned int num_channels = map.num_channels;
+    std::vector<int16_t> dst(dst_frames * num_channels);
+    std::vector<int16_t> actual;
+
+    for (;;) {
+      const size_t num_frames =
+          samething_core_frames_render(&ctx, &map, dst.data(), dst_frames);
+
+      ASSERT_LE(num_frames, dst_frames);
+      actual.insert(actual.end(), dst.begin(),
+                    dst.begin() + (num_frames * num_channels));
+
+      if (num_frames < dst_frames) {
+        break;
+      }
+    }
+    ASSERT_EQ(actual.size(), mono.size() * num_channels);
+
+    for (size_t frame = 0; frame < mono.size(); ++frame) {
+      for (unsigned int channel = 0; channel < num_channels; ++channel) {
+        const bool muted = (map.mute_mask >> channel) & 1U;
+        const int16_t expected = static_cast<int16_t>(
+            muted ? 0 : ((mono[frame] * map.gains[channel]) >> 14));
+
+        ASSERT_EQ(actual[(frame * num_channels) + channel], expected)
+            << "frame " << frame << ", channel " << channel;
+      }
+    }
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "0015",
+      .originator_code = "WXR",
+      .event_code = "TOR",
+      .callsign = "KXYZ/NWS",
+      .originator_time = "1231200",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  struct samething_core_channel_map map;
+  std::vector<int16_t> mono;
+};
+
+TEST_P(FramesRenderTest, SingleFrameBuffer) { VerifyRender(1); }
+
+TEST_P(FramesRenderTest, OddSizedBuffer) { VerifyRender(1001); }
+
+TEST_P(FramesRenderTest, BufferLargerThanChunk) { VerifyRender(44100); }
+
+INSTANTIATE_TEST_SUITE_P(samething_core_frames_render, FramesRenderTest,
+                         ::testing::Range(1U,
+                                          SAMETHING_CORE_CHANNELS_NUM_MAX + 1));
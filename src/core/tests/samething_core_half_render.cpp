@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif  // defined(__x86_64__) || defined(__i386__)
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_half_render() asserts when the generation
+/// context specified is NULL.
+TEST(samething_core_half_render, AssertsWhenContextIsNULL) {
+  int16_t buffer[2];
+  EXPECT_DEATH({ samething_core_half_render(nullptr, buffer, 1, 0); }, ".*");
+}
+
+/// Checks to see if samething_core_half_render() asserts when the double
+/// buffer specified is NULL.
+TEST(samething_core_half_render, AssertsWhenBufferIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  EXPECT_DEATH({ samething_core_half_render(&ctx, nullptr, 1, 0); }, ".*");
+}
+
+/// Checks to see if samething_core_half_render() asserts when the halves of the
+/// double buffer are empty.
+TEST(samething_core_half_render, AssertsWhenHalfSizeIsZero) {
+  struct samething_core_gen_ctx ctx = {};
+  int16_t buffer[2];
+  EXPECT_DEATH({ samething_core_half_render(&ctx, buffer, 0, 0); }, ".*");
+}
+
+/// Checks to see if samething_core_half_render() asserts when the half
+/// specified doesn't exist.
+TEST(samething_core_half_render, AssertsWhenHalfIsInvalid) {
+  struct samething_core_gen_ctx ctx = {};
+  int16_t buffer[2];
+  EXPECT_DEATH({ samething_core_half_render(&ctx, buffer, 1, 2); }, ".*");
+}
+#endif  // NDEBUG
+
+/// Reads the cycle counter of the host CPU, or a nanosecond clock where there
+/// isn't one available.
+static std::uint64_t CyclesNow() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif  // defined(__x86_64__) || defined(__i386__)
+}
+
+class HalfRenderTest : public ::testing::Test {
+ protected:
+  /// The number of samples in each half of the double buffer.
+  static constexpr size_t kHalfSize = 256;
+
+  /// A sample value that is never generated, used to detect samples which are
+  /// left alone.
+  static constexpr int16_t kUntouched = INT16_MIN;
+
+  void SetUp() override {
+    ctx = {};
+    samething_core_ctx_init(&ctx, &header);
+
+    struct samething_core_gen_ctx ref_ctx = {};
+    samething_core_ctx_init(&ref_ctx, &header);
+
+    expected.resize(samething_core_seq_spans_get(&ref_ctx, nullptr));
+    samething_core_samples_render(&ref_ctx, expected.data(), expected.size());
+
+    std::fill(std::begin(buffer), std::end(buffer), kUntouched);
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t buffer[2 * kHalfSize];
+  std::vector<int16_t> expected;
+};
+
+/// Checks that filling alternating halves yields the same stream as
+/// samething_core_samples_render(), and that each fill leaves the other half
+/// alone.
+TEST_F(HalfRenderTest, AlternatingHalvesMatchSamplesRender) {
+  std::vector<int16_t> actual;
+
+  for (unsigned int half = 0;; half ^= 1) {
+    int16_t *const other = &buffer[(half ^ 1) * kHalfSize];
+    std::fill(other, &other[kHalfSize], kUntouched);
+
+    const size_t num_samples =
+        samething_core_half_render(&ctx, buffer, kHalfSize, half);
+
+    ASSERT_LE(num_samples, kHalfSize);
+    ASSERT_TRUE(std::all_of(other, &other[kHalfSize], [](const int16_t s) {
+      return s == kUntouched;
+    }));
+
+    const int16_t *const filled = &buffer[half * kHalfSize];
+    actual.insert(actual.end(), filled, &filled[num_samples]);
+
+    if (num_samples < kHalfSize) {
+      break;
+    }
+  }
+  EXPECT_EQ(actual, expected);
+}
+
+/// Checks that whatever follows the end of the message is filled with silence,
+/// including any halves filled after it.
+TEST_F(HalfRenderTest, PadsWithSilenceAfterEnd) {
+  samething_core_seek(&ctx, expected.size() - 10);
+
+  EXPECT_EQ(samething_core_half_render(&ctx, buffer, kHalfSize, 1), 10U);
+
+  for (size_t i = 0; i < kHalfSize; ++i) {
+    const int16_t sample = (i < 10) ? expected[expected.size() - 10 + i] : 0;
+    EXPECT_EQ(buffer[kHalfSize + i], sample) << "sample " << i;
+  }
+
+  EXPECT_EQ(samething_core_half_render(&ctx, buffer, kHalfSize, 0), 0U);
+
+  for (size_t i = 0; i < kHalfSize; ++i) {
+    EXPECT_EQ(buffer[i], 0) << "sample " << i;
+  }
+}
+
+/// Simulates a DMA engine draining the double buffer at the sample rate while
+/// every half is filled from its interrupt, and checks that even the slowest
+/// fill of the whole message finishes before its deadline: the time it takes
+/// the DMA engine to drain the other half.
+TEST_F(HalfRenderTest, WorstCaseFillMeetsDeadline) {
+  // Each half is filled a few times from the same position, keeping the
+  // fastest, so that the host preempting the test isn't mistaken for a slow
+  // fill.
+  constexpr int kAttempts = 3;
+
+  const std::chrono::nanoseconds deadline(
+      (kHalfSize * UINT64_C(1000000000)) / SAMETHING_CORE_SAMPLE_RATE);
+
+  std::chrono::nanoseconds worst_time(0);
+  std::uint64_t worst_cycles = 0;
+  size_t worst_half = 0;
+  size_t num_halves = 0;
+
+  for (size_t num_samples = kHalfSize; num_samples == kHalfSize;
+       ++num_halves) {
+    const struct samething_core_cursor start = ctx.cursor;
+
+    auto time = std::chrono::nanoseconds::max();
+    std::uint64_t cycles = UINT64_MAX;
+
+    for (int attempt = 0; attempt < kAttempts; ++attempt) {
+      ctx.cursor = start;
+
+      const auto time_start = std::chrono::steady_clock::now();
+      const std::uint64_t cycles_start = CyclesNow();
+
+      num_samples = samething_core_half_render(&ctx, buffer, kHalfSize,
+                                               num_halves % 2);
+
+      const std::uint64_t cycles_end = CyclesNow();
+      const auto time_end = std::chrono::steady_clock::now();
+
+      cycles = std::min(cycles, cycles_end - cycles_start);
+      time = std::min(time, std::chrono::nanoseconds(time_end - time_start));
+    }
+
+    if (time > worst_time) {
+      worst_time = time;
+      worst_half = num_halves;
+    }
+    worst_cycles = std::max(worst_cycles, cycles);
+  }
+
+  RecordProperty("halves", std::to_string(num_halves));
+  RecordProperty("worst_half", std::to_string(worst_half));
+  RecordProperty("worst_cycles", std::to_string(worst_cycles));
+  RecordProperty("worst_ns", std::to_string(worst_time.count()));
+
+  EXPECT_LT(worst_time, deadline)
+      << "half " << worst_half << " of " << num_halves << " took "
+      << worst_time.count() << " ns (" << worst_cycles << " cycles)";
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_header_format() asserts when the header
+/// specified is NULL.
+TEST(samething_core_header_format, AssertsWhenHeaderIsNULL) {
+  char text[SAMETHING_CORE_HEADER_TEXT_LEN_MAX + 1];
+  EXPECT_DEATH({ samething_core_header_format(nullptr, text); }, ".*");
+}
+
+/// Checks to see if samething_core_header_format() asserts when the text
+/// specified is NULL.
+TEST(samething_core_header_format, AssertsWhenTextIsNULL) {
+  const struct samething_core_header header = {};
+  EXPECT_DEATH({ samething_core_header_format(&header, nullptr); }, ".*");
+}
+#endif  // NDEBUG
+
+/// Checks that a header is formatted the way it's transmitted.
+TEST(samething_core_header_format, Header) {
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  char text[SAMETHING_CORE_HEADER_TEXT_LEN_MAX + 1];
+  const std::string expected =
+      "ZCZC-ORG-RED-101010-828282+2138-3939393-XIPHIAS -";
+
+  EXPECT_EQ(samething_core_header_format(&header, text), expected.size());
+  EXPECT_EQ(text, expected);
+
+  // The text is what follows the preamble of the header burst.
+  struct samething_core_gen_ctx ctx;
+  samething_core_ctx_init(&ctx, &header);
+
+  ASSERT_EQ(ctx.header_size, SAMETHING_CORE_PREAMBLE_NUM + expected.size());
+  EXPECT_EQ(std::memcmp(&ctx.header_data[SAMETHING_CORE_PREAMBLE_NUM], text,
+                        expected.size()),
+            0);
+}
+
+/// Checks that the longest header fits, and comes back from being parsed as
+/// the same text.
+TEST(samething_core_header_format, RoundTripLongest) {
+  std::string expected = "ZCZC-CIV-EVI";
+
+  for (size_t i = 0; i < SAMETHING_CORE_LOCATION_CODES_NUM_MAX; ++i) {
+    expected += "-1" + std::to_string(10000 + i);
+  }
+  expected += "+9930-3662359-~!\"#/,. -";
+
+  ASSERT_EQ(expected.size(), SAMETHING_CORE_HEADER_TEXT_LEN_MAX);
+
+  struct samething_core_header header = {};
+
+  ASSERT_EQ(samething_core_header_parse(&header, expected.data(),
+                                        expected.size(), nullptr),
+            SAMETHING_CORE_PARSE_ERROR_NONE);
+
+  char text[SAMETHING_CORE_HEADER_TEXT_LEN_MAX + 1];
+
+  EXPECT_EQ(samething_core_header_format(&header, text), expected.size());
+  EXPECT_EQ(text, expected);
+}
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_header_parse() asserts when the header
+/// specified is NULL.
+TEST(samething_core_header_parse, AssertsWhenHeaderIsNULL) {
+  EXPECT_DEATH({ samething_core_header_parse(nullptr, "ZCZC", 4, nullptr); },
+               ".*");
+}
+
+/// Checks to see if samething_core_header_parse() asserts when the text
+/// specified is NULL but isn't empty.
+TEST(samething_core_header_parse, AssertsWhenTextIsNULL) {
+  struct samething_core_header header;
+  EXPECT_DEATH({ samething_core_header_parse(&header, nullptr, 4, nullptr); },
+               ".*");
+}
+#endif  // NDEBUG
+
+namespace {
+
+constexpr const char *kValidText =
+    "ZCZC-WXR-TOR-048484-048485+0030-1231200-KEC61/NW-";
+
+/// Parses text, and checks that it fails with the error specified at the
+/// position specified.
+void VerifyError(const std::string &text,
+                 const enum samething_core_parse_error expected_error,
+                 const size_t expected_pos) {
+  struct samething_core_header header = {};
+  size_t pos = 0;
+
+  EXPECT_EQ(samething_core_header_parse(&header, text.data(), text.size(),
+                                        &pos),
+            expected_error)
+      << text;
+  EXPECT_EQ(pos, expected_pos) << text;
+}
+
+/// Replaces the character at a position within the valid text.
+std::string Replace(const size_t pos, const char c) {
+  std::string text = kValidText;
+  text[pos] = c;
+  return text;
+}
+
+}  // namespace
+
+/// Checks that every field of a valid header is parsed, and that the end
+/// marker follows the location codes.
+TEST(samething_core_header_parse, ValidHeader) {
+  struct samething_core_header header = {};
+  header.attn_sig_duration = 9;
+
+  size_t pos = 12345;
+
+  EXPECT_EQ(samething_core_header_parse(&header, kValidText,
+                                        std::strlen(kValidText), &pos),
+            SAMETHING_CORE_PARSE_ERROR_NONE);
+  EXPECT_EQ(pos, 12345U);
+
+  EXPECT_STREQ(header.originator_code, "WXR");
+  EXPECT_STREQ(header.event_code, "TOR");
+  EXPECT_STREQ(header.location_codes[0], "048484");
+  EXPECT_STREQ(header.location_codes[1], "048485");
+  EXPECT_STREQ(header.location_codes[2],
+               SAMETHING_CORE_LOCATION_CODE_END_MARKER);
+  EXPECT_STREQ(header.valid_time_period, "0030");
+  EXPECT_STREQ(header.originator_time, "1231200");
+  EXPECT_STREQ(header.callsign, "KEC61/NW");
+  EXPECT_EQ(header.attn_sig_duration, 9U);
+}
+
+/// Checks that a header with the most location codes allowed is parsed without
+/// an end marker, and that one more is rejected.
+TEST(samething_core_header_parse, LocationCodesNumMax) {
+  std::string text = "ZCZC-EAS-RWT";
+
+  for (size_t i = 0; i < SAMETHING_CORE_LOCATION_CODES_NUM_MAX; ++i) {
+    text += "-0000" + std::to_string(i % 10) + std::to_string(i / 10);
+  }
+
+  const std::string tail = "+0100-0010000-WXYZ/FM -";
+  struct samething_core_header header = {};
+
+  EXPECT_EQ(samething_core_header_parse(&header, (text + tail).data(),
+                                        text.size() + tail.size(), nullptr),
+            SAMETHING_CORE_PARSE_ERROR_NONE);
+  EXPECT_STREQ(header.location_codes[SAMETHING_CORE_LOCATION_CODES_NUM_MAX - 1],
+               "000003");
+
+  VerifyError(text + "-000000" + tail,
+              SAMETHING_CORE_PARSE_ERROR_LOCATION_CODES_NUM, text.size());
+}
+
+/// Checks that a header without location codes is rejected.
+TEST(samething_core_header_parse, NoLocationCodes) {
+  VerifyError("ZCZC-WXR-TOR+0030-1231200-KEC61/NW-",
+              SAMETHING_CORE_PARSE_ERROR_LOCATION_CODES_NUM, 12);
+}
+
+/// Checks that text which ends early is rejected at its end, wherever it ends.
+TEST(samething_core_header_parse, Truncated) {
+  const std::string text = kValidText;
+
+  for (size_t len = 0; len < text.size(); ++len) {
+    VerifyError(text.substr(0, len), SAMETHING_CORE_PARSE_ERROR_TRUNCATED,
+                len);
+  }
+}
+
+/// Checks that text which doesn't start with the ASCII identifier is rejected.
+TEST(samething_core_header_parse, BadAsciiId) {
+  VerifyError("NNNN", SAMETHING_CORE_PARSE_ERROR_ASCII_ID, 0);
+  VerifyError(Replace(3, 'Z'), SAMETHING_CORE_PARSE_ERROR_ASCII_ID, 3);
+}
+
+/// Checks that a character outside of the class of its field is rejected
+/// where it is.
+TEST(samething_core_header_parse, BadCharacter) {
+  // Originator code, event code, location codes, valid time period,
+  // originator time and callsign, in that order.
+  VerifyError(Replace(6, 'x'), SAMETHING_CORE_PARSE_ERROR_CHARACTER, 6);
+  VerifyError(Replace(11, '1'), SAMETHING_CORE_PARSE_ERROR_CHARACTER, 11);
+  VerifyError(Replace(18, 'A'), SAMETHING_CORE_PARSE_ERROR_CHARACTER, 18);
+  VerifyError(Replace(25, ' '), SAMETHING_CORE_PARSE_ERROR_CHARACTER, 25);
+  VerifyError(Replace(29, '/'), SAMETHING_CORE_PARSE_ERROR_CHARACTER, 29);
+  VerifyError(Replace(32, '\x80'), SAMETHING_CORE_PARSE_ERROR_CHARACTER, 32);
+  VerifyError(Replace(44, '-'), SAMETHING_CORE_PARSE_ERROR_CHARACTER, 44);
+  VerifyError(Replace(47, '\n'), SAMETHING_CORE_PARSE_ERROR_CHARACTER, 47);
+}
+
+/// Checks that a missing or wrong separator is rejected where it should be.
+TEST(samething_core_header_parse, BadSeparator) {
+  VerifyError(Replace(4, '+'), SAMETHING_CORE_PARSE_ERROR_SEPARATOR, 4);
+  VerifyError(Replace(8, '_'), SAMETHING_CORE_PARSE_ERROR_SEPARATOR, 8);
+  VerifyError(Replace(26, '_'), SAMETHING_CORE_PARSE_ERROR_SEPARATOR, 26);
+  VerifyError(Replace(31, '+'), SAMETHING_CORE_PARSE_ERROR_SEPARATOR, 31);
+  VerifyError(Replace(39, '+'), SAMETHING_CORE_PARSE_ERROR_SEPARATOR, 39);
+  VerifyError(Replace(48, ' '), SAMETHING_CORE_PARSE_ERROR_SEPARATOR, 48);
+}
+
+/// Checks that days, hours and minutes out of range are rejected at the start
+/// of the one which is.
+TEST(samething_core_header_parse, BadValue) {
+  std::string text = kValidText;
+
+  VerifyError(text.replace(27, 4, "0060"), SAMETHING_CORE_PARSE_ERROR_VALUE,
+              29);
+
+  text = kValidText;
+  VerifyError(text.replace(32, 3, "000"), SAMETHING_CORE_PARSE_ERROR_VALUE,
+              32);
+
+  text = kValidText;
+  VerifyError(text.replace(32, 3, "367"), SAMETHING_CORE_PARSE_ERROR_VALUE,
+              32);
+
+  text = kValidText;
+  VerifyError(text.replace(35, 2, "24"), SAMETHING_CORE_PARSE_ERROR_VALUE, 35);
+
+  text = kValidText;
+  VerifyError(text.replace(37, 2, "60"), SAMETHING_CORE_PARSE_ERROR_VALUE, 37);
+}
+
+/// Checks that text going on past the end of the header is rejected.
+TEST(samething_core_header_parse, Trailing) {
+  const std::string text = kValidText;
+
+  VerifyError(text + "\n", SAMETHING_CORE_PARSE_ERROR_TRAILING, text.size());
+  VerifyError(text + "NNNN", SAMETHING_CORE_PARSE_ERROR_TRAILING,
+              text.size());
+}
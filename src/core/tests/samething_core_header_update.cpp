@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_header_update() asserts when the generation
+/// context specified is NULL.
+TEST(samething_core_header_update, AssertsWhenContextIsNULL) {
+  const struct samething_core_header header = {};
+  struct samething_core_seq_span changed;
+
+  EXPECT_DEATH(
+      { samething_core_header_update(nullptr, &header, &changed); }, ".*");
+}
+
+/// Checks to see if samething_core_header_update() asserts when the header
+/// specified is NULL.
+TEST(samething_core_header_update, AssertsWhenHeaderIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  struct samething_core_seq_span changed;
+
+  EXPECT_DEATH({ samething_core_header_update(&ctx, nullptr, &changed); },
+               ".*");
+}
+
+/// Checks to see if samething_core_header_update() asserts when the changed
+/// span specified is NULL.
+TEST(samething_core_header_update, AssertsWhenChangedIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  const struct samething_core_header header = {};
+
+  EXPECT_DEATH({ samething_core_header_update(&ctx, &header, nullptr); },
+               ".*");
+}
+#endif  // NDEBUG
+
+class HeaderUpdateTest : public ::testing::TestWithParam<unsigned int> {
+ protected:
+  /// Configures a generation context for the header specified at the sample
+  /// rate under test.
+  void Configure(struct samething_core_gen_ctx *const ctx,
+                 const struct samething_core_header &configured) {
+    if (GetParam() != 0) {
+      samething_core_ctx_rate_init(ctx, &configured, GetParam());
+    } else {
+      samething_core_ctx_init(ctx, &configured);
+    }
+  }
+
+  /// Renders all of the samples of a message.
+  static std::vector<int16_t> Render(
+      const struct samething_core_gen_ctx &ctx) {
+    std::vector<int16_t> samples(samething_core_seq_spans_get(&ctx, nullptr));
+
+    EXPECT_EQ(samething_core_range_render(&ctx, 0, samples.data(),
+                                          samples.size()),
+              samples.size());
+    return samples;
+  }
+
+  /// Renders the header burst of a message.
+  static std::vector<int16_t> RenderBurst(
+      const struct samething_core_gen_ctx &ctx) {
+    struct samething_core_seq_span spans[SAMETHING_CORE_SEQ_STATE_NUM];
+
+    samething_core_seq_spans_get(&ctx, spans);
+
+    const struct samething_core_seq_span &burst =
+        spans[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST];
+    std::vector<int16_t> samples(burst.num_samples);
+
+    samething_core_range_render(&ctx, burst.start, samples.data(),
+                                samples.size());
+    return samples;
+  }
+
+  /// Updates the generation context to the header specified, and checks that
+  /// it ends up exactly as configuring it from scratch would leave it, and
+  /// that rendering only the span which changed brings an old copy of the
+  /// header burst up to date.
+  ///
+  /// @returns What samething_core_header_update() returned.
+  bool VerifyUpdate(const struct samething_core_header &updated) {
+    struct samething_core_gen_ctx ctx = {};
+    Configure(&ctx, header);
+
+    std::vector<int16_t> burst = RenderBurst(ctx);
+
+    // Leave generation part of the way through, which the update must undo.
+    std::vector<int16_t> scratch(1000);
+    samething_core_samples_render(&ctx, scratch.data(), scratch.size());
+
+    struct samething_core_seq_span changed;
+    const bool in_place =
+        samething_core_header_update(&ctx, &updated, &changed);
+
+    struct samething_core_gen_ctx expected = {};
+    Configure(&expected, updated);
+
+    EXPECT_EQ(ctx.header_size, expected.header_size);
+    EXPECT_EQ(std::memcmp(ctx.header_data, expected.header_data,
+                          expected.header_size),
+              0);
+    EXPECT_EQ(ctx.header_plan_size, expected.header_plan_size);
+    EXPECT_EQ(std::memcmp(ctx.header_plan, expected.header_plan,
+                          expected.header_plan_size),
+              0);
+    EXPECT_EQ(ctx.attn_sig_samples_num, expected.attn_sig_samples_num);
+    EXPECT_EQ(ctx.sample_rate, expected.sample_rate);
+    EXPECT_EQ(ctx.sample_rate_index, expected.sample_rate_index);
+    EXPECT_EQ(Render(ctx), Render(expected));
+
+    const std::vector<int16_t> expected_burst = RenderBurst(expected);
+
+    if (!in_place) {
+      EXPECT_EQ(changed.start, 0U);
+      EXPECT_EQ(changed.num_samples, expected_burst.size());
+      return in_place;
+    }
+
+    EXPECT_LE(changed.start + changed.num_samples, burst.size());
+    EXPECT_EQ(samething_core_range_render(&ctx, changed.start,
+                                          &burst[changed.start],
+                                          changed.num_samples),
+              changed.num_samples);
+    EXPECT_EQ(burst, expected_burst);
+    return in_place;
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+};
+
+/// Checks that nothing changes when the header is the same.
+TEST_P(HeaderUpdateTest, SameHeader) {
+  struct samething_core_gen_ctx ctx = {};
+  Configure(&ctx, header);
+
+  struct samething_core_seq_span changed = {1, 1};
+
+  EXPECT_TRUE(samething_core_header_update(&ctx, &header, &changed));
+  EXPECT_EQ(changed.num_samples, 0U);
+  EXPECT_TRUE(VerifyUpdate(header));
+}
+
+/// Checks that only the bits of the originator time are rendered again when
+/// only it changes.
+TEST_P(HeaderUpdateTest, OriginatorTime) {
+  struct samething_core_header updated = header;
+  std::memcpy(updated.originator_time, "3940001", 7);
+
+  EXPECT_TRUE(VerifyUpdate(updated));
+
+  struct samething_core_gen_ctx ctx = {};
+  Configure(&ctx, header);
+
+  struct samething_core_seq_span changed;
+  samething_core_header_update(&ctx, &updated, &changed);
+
+  // Only the last four characters changed, and none of the callsign did.
+  struct samething_core_seq_span spans[SAMETHING_CORE_SEQ_STATE_NUM];
+  samething_core_seq_spans_get(&ctx, spans);
+
+  const size_t burst_samples =
+      spans[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST].num_samples;
+
+  EXPECT_GT(changed.start, burst_samples / 2);
+  EXPECT_GT(changed.num_samples, 0U);
+#ifdef SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  if (GetParam() == 0) {
+    EXPECT_EQ(changed.start + changed.num_samples, burst_samples);
+    return;
+  }
+#endif  // SAMETHING_CORE_AFSK_CONTINUOUS_PHASE
+  EXPECT_LT(changed.start + changed.num_samples, burst_samples);
+  EXPECT_LT(changed.num_samples, burst_samples / 8);
+}
+
+/// Checks that every field can be updated in place.
+TEST_P(HeaderUpdateTest, EveryField) {
+  struct samething_core_header updated = header;
+
+  std::memcpy(updated.originator_code, "WXR", 3);
+  std::memcpy(updated.event_code, "TOR", 3);
+  std::memcpy(updated.location_codes[0], "048484", 6);
+  std::memcpy(updated.location_codes[1], "048485", 6);
+  std::memcpy(updated.valid_time_period, "0030", 4);
+  std::memcpy(updated.callsign, "KEC61/NW", 8);
+  std::memcpy(updated.originator_time, "1231200", 7);
+  updated.attn_sig_duration = 10;
+
+  EXPECT_TRUE(VerifyUpdate(updated));
+}
+
+/// Checks that the header is rebuilt when a location code is added.
+TEST_P(HeaderUpdateTest, LocationCodeAdded) {
+  struct samething_core_header updated = header;
+
+  std::memcpy(updated.location_codes[2], "777777", 6);
+  std::memcpy(updated.location_codes[3],
+              SAMETHING_CORE_LOCATION_CODE_END_MARKER, 6);
+
+  EXPECT_FALSE(VerifyUpdate(updated));
+}
+
+/// Checks that the header is rebuilt when a location code is removed.
+TEST_P(HeaderUpdateTest, LocationCodeRemoved) {
+  struct samething_core_header updated = header;
+
+  std::memcpy(updated.location_codes[1],
+              SAMETHING_CORE_LOCATION_CODE_END_MARKER, 6);
+
+  EXPECT_FALSE(VerifyUpdate(updated));
+}
+
+INSTANTIATE_TEST_SUITE_P(SampleRates, HeaderUpdateTest,
+                         ::testing::Values(0U, 8000U, 48000U));
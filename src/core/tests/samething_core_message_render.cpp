@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+#include "samething/core_constexpr.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+#endif  // NDEBUG
+
+namespace {
+
+constexpr samething_core_header kWeeklyTest = {
+    .location_codes = {"101010", "828282",
+                       SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+    .valid_time_period = "0015",
+    .originator_code = "WXR",
+    .event_code = "RWT",
+    .callsign = "XIPHIAS ",
+    .originator_time = "3939393",
+    .attn_sig_duration = 2,
+    .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+constexpr samething_core_header kNoLocationsNoAttnSig = {
+    .location_codes = {SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+    .valid_time_period = "0100",
+    .originator_code = "CIV",
+    .event_code = "ADR",
+    .callsign = "KXYZ/FM ",
+    .originator_time = "0011200",
+    .attn_sig_duration = 0,
+    .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+constexpr samething_core_header kNwrWeeklyTest = {
+    .location_codes = {"048484", SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+    .valid_time_period = "0030",
+    .originator_code = "WXR",
+    .event_code = "RWT",
+    .callsign = "KEC61/NW",
+    .originator_time = "1231200",
+    .attn_sig_duration = 2,
+    .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_NWR};
+
+// All are rendered entirely at compile time.
+constexpr auto &kWeeklyTestSamples = samething::core::kMessage<kWeeklyTest>;
+constexpr auto &kNoLocationsNoAttnSigSamples =
+    samething::core::kMessage<kNoLocationsNoAttnSig>;
+constexpr auto &kNwrWeeklyTestSamples =
+    samething::core::kMessage<kNwrWeeklyTest>;
+
+// The first bit of the preamble is a mark bit, which starts at phase 0.
+static_assert(kWeeklyTestSamples[0] == 0);
+static_assert(kWeeklyTestSamples[1] > 0);
+
+/// Generates a message at runtime.
+std::vector<int16_t> RuntimeRender(const samething_core_header &header) {
+  struct samething_core_gen_ctx ctx = {};
+  samething_core_ctx_init(&ctx, &header);
+
+  std::vector<int16_t> samples(samething_core_seq_spans_get(&ctx, nullptr));
+  samething_core_samples_render(&ctx, samples.data(), samples.size());
+
+  return samples;
+}
+
+/// Checks that a message rendered at compile time matches one generated at
+/// runtime: exactly with the fixed point tone kernel, and otherwise to within
+/// the difference between the fixed point and floating point tone kernels.
+template <std::size_t N>
+void VerifyMatchesRuntime(const std::array<int16_t, N> &samples,
+                          const samething_core_header &header) {
+  const std::vector<int16_t> expected = RuntimeRender(header);
+
+  ASSERT_EQ(samples.size(), expected.size());
+
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+#ifdef SAMETHING_CORE_FIXED_POINT
+    ASSERT_EQ(samples[i], expected[i]) << "sample " << i;
+#else
+    ASSERT_NEAR(samples[i], expected[i], 2) << "sample " << i;
+#endif  // SAMETHING_CORE_FIXED_POINT
+  }
+}
+
+}  // namespace
+
+/// Checks that the size of a message is known at compile time, and matches
+/// what the runtime reports.
+TEST(samething_core_message_render, SizeMatchesRuntime) {
+  struct samething_core_gen_ctx ctx = {};
+  samething_core_ctx_init(&ctx, &kWeeklyTest);
+
+  static_assert(samething::core::MessageSamplesNum(kWeeklyTest) ==
+                kWeeklyTestSamples.size());
+  EXPECT_EQ(kWeeklyTestSamples.size(),
+            samething_core_seq_spans_get(&ctx, nullptr));
+}
+
+/// Checks that a message with location codes and an attention signal matches
+/// the runtime path.
+TEST(samething_core_message_render, MatchesRuntime) {
+  VerifyMatchesRuntime(kWeeklyTestSamples, kWeeklyTest);
+}
+
+/// Checks that a message without location codes or an attention signal
+/// matches the runtime path.
+TEST(samething_core_message_render, MatchesRuntimeWithoutLocationsOrAttnSig) {
+  VerifyMatchesRuntime(kNoLocationsNoAttnSigSamples, kNoLocationsNoAttnSig);
+}
+
+/// Checks that a message with the NOAA Weather Radio (NWR) attention signal
+/// matches the runtime path.
+TEST(samething_core_message_render, MatchesRuntimeWithNwrAttnSig) {
+  VerifyMatchesRuntime(kNwrWeeklyTestSamples, kNwrWeeklyTest);
+}
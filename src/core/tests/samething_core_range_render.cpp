@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_range_render() asserts when the generation
+/// context specified is NULL.
+TEST(samething_core_range_render, AssertsWhenContextIsNULL) {
+  int16_t dst[1];
+  EXPECT_DEATH({ samething_core_range_render(nullptr, 0, dst, 1); }, ".*");
+}
+#endif  // NDEBUG
+
+class RangeRenderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ctx = {};
+    samething_core_ctx_init(&ctx, &header);
+
+    struct samething_core_gen_ctx ref_ctx = {};
+    samething_core_ctx_init(&ref_ctx, &header);
+
+    while (ref_ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
+      const size_t num_samples =
+          samething_core_samples_gen(&ref_ctx, sample_data);
+
+      expected.insert(expected.end(), sample_data,
+                      &sample_data[num_samples]);
+    }
+  }
+
+  /// Splits the message into the number of ranges specified, renders each of
+  /// them on its own thread, and checks that the result matches the reference
+  /// stream.
+  void VerifyParallel(const size_t num_workers) {
+    std::vector<int16_t> actual(expected.size());
+    std::vector<std::thread> workers;
+
+    const size_t range = (expected.size() + num_workers - 1) / num_workers;
+
+    for (size_t i = 0; i < num_workers; ++i) {
+      workers.emplace_back([&, i]() {
+        const size_t start = i * range;
+        const size_t end = std::min(start + range, actual.size());
+
+        EXPECT_EQ(samething_core_range_render(&ctx, start, &actual[start],
+                                              end - start),
+                  end - start);
+      });
+    }
+
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    EXPECT_EQ(actual, expected);
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  std::vector<int16_t> expected;
+};
+
+TEST_F(RangeRenderTest, OneWorker) { VerifyParallel(1); }
+
+TEST_F(RangeRenderTest, FourWorkers) { VerifyParallel(4); }
+
+TEST_F(RangeRenderTest, OddNumberOfWorkers) { VerifyParallel(13); }
+
+/// Checks that the generation context is left untouched.
+TEST_F(RangeRenderTest, ContextIsNotAltered) {
+  const struct samething_core_gen_ctx before = ctx;
+  std::vector<int16_t> dst(5000);
+
+  samething_core_range_render(&ctx, 100000, dst.data(), dst.size());
+  EXPECT_EQ(std::memcmp(&before, &ctx, sizeof(ctx)), 0);
+}
+
+/// Checks that a range going past the end of the message is cut short.
+TEST_F(RangeRenderTest, RangePastEnd) {
+  std::vector<int16_t> dst(5000);
+
+  EXPECT_EQ(samething_core_range_render(&ctx, expected.size() - 100,
+                                        dst.data(), dst.size()),
+            100U);
+  EXPECT_EQ(samething_core_range_render(&ctx, expected.size() + 100,
+                                        dst.data(), dst.size()),
+            0U);
+}
@@ -36,15 +36,24 @@ extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
 /// state specified is >=SAMETHING_CORE_SEQ_STATE_NUM.
 TEST(samething_core_samples_gen, AssertsWhenSeqStateIsInvalid) {
   struct samething_core_gen_ctx ctx = {};
-  ctx.seq_state = SAMETHING_CORE_SEQ_STATE_NUM;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  ctx.cursor.seq_state = SAMETHING_CORE_SEQ_STATE_NUM;
 
-  EXPECT_DEATH({ samething_core_samples_gen(&ctx); }, ".*");
+  EXPECT_DEATH({ samething_core_samples_gen(&ctx, sample_data); }, ".*");
 }
 
 /// Checks to see if samething_core_samples_gen() asserts when the generation
 /// context specified is NULL.
 TEST(samething_core_samples_gen, AssertsWhenContextIsNULL) {
-  EXPECT_DEATH({ samething_core_samples_gen(nullptr); }, ".*");
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  EXPECT_DEATH({ samething_core_samples_gen(nullptr, sample_data); }, ".*");
+}
+
+/// Checks to see if samething_core_samples_gen() asserts when the sample buffer
+/// specified is NULL.
+TEST(samething_core_samples_gen, AssertsWhenSampleDataIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  EXPECT_DEATH({ samething_core_samples_gen(&ctx, nullptr); }, ".*");
 }
 #endif  // NDEBUG
 
@@ -55,19 +64,21 @@ class SeqStateTransitionTest : public ::testing::Test {
   void VerifyTransition(
       const enum samething_core_seq_state start_state,
       const enum samething_core_seq_state expected_state) noexcept {
-    ctx.seq_state = start_state;
+    struct samething_core_seq_span spans[SAMETHING_CORE_SEQ_STATE_NUM];
+
     samething_core_ctx_init(&ctx, &header);
+    samething_core_seq_spans_get(&ctx, spans);
+    samething_core_seek(&ctx, spans[start_state].start);
 
-    const unsigned int num_samples_expected =
-        ctx.seq_samples_remaining[start_state];
+    const size_t num_samples_expected = spans[start_state].num_samples;
 
-    unsigned int count = 0;
+    size_t count = 0;
 
     while (count < num_samples_expected) {
-      samething_core_samples_gen(&ctx);
+      samething_core_samples_gen(&ctx, sample_data);
       count += SAMETHING_CORE_SAMPLES_NUM_MAX;
     }
-    EXPECT_EQ(ctx.seq_state, expected_state);
+    EXPECT_EQ(ctx.cursor.seq_state, expected_state);
   }
 
  private:
@@ -79,9 +90,11 @@ class SeqStateTransitionTest : public ::testing::Test {
       .event_code = "RED",
       .callsign = "XIPHIAS ",
       .originator_time = "3939393",
-      .attn_sig_duration = 8};
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
 
   struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
 };
 
 TEST_F(SeqStateTransitionTest, FirstAFSKHeaderToFirstSilence) {
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_samples_render() asserts when the
+/// generation context specified is NULL.
+TEST(samething_core_samples_render, AssertsWhenContextIsNULL) {
+  int16_t dst[1];
+  EXPECT_DEATH({ samething_core_samples_render(nullptr, dst, 1); }, ".*");
+}
+
+/// Checks to see if samething_core_samples_render() asserts when the buffer
+/// specified is NULL but is not empty.
+TEST(samething_core_samples_render, AssertsWhenDstIsNULL) {
+  struct samething_core_gen_ctx ctx = {};
+  EXPECT_DEATH({ samething_core_samples_render(&ctx, nullptr, 1); }, ".*");
+}
+#endif  // NDEBUG
+
+class SamplesRenderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ctx = {};
+    samething_core_ctx_init(&ctx, &header);
+
+    // The reference stream is generated in fixed size chunks.
+    struct samething_core_gen_ctx ref_ctx = {};
+    samething_core_ctx_init(&ref_ctx, &header);
+
+    while (ref_ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
+      const size_t num_samples =
+          samething_core_samples_gen(&ref_ctx, sample_data);
+
+      expected.insert(expected.end(), sample_data,
+                      &sample_data[num_samples]);
+    }
+  }
+
+  /// Renders the whole message with buffers of the size specified, and checks
+  /// that the stream matches the reference stream.
+  void VerifyRender(const size_t dst_size) {
+    std::vector<int16_t> dst(dst_size);
+    std::vector<int16_t> actual;
+
+    for (;;) {
+      const size_t num_samples =
+          samething_core_samples_render(&ctx, dst.data(), dst_size);
+
+      ASSERT_LE(num_samples, dst_size);
+      actual.insert(actual.end(), dst.begin(), dst.begin() + num_samples);
+
+      if (num_samples < dst_size) {
+        break;
+      }
+    }
+    EXPECT_EQ(ctx.cursor.seq_state, SAMETHING_CORE_SEQ_STATE_NUM);
+    EXPECT_EQ(samething_core_samples_render(&ctx, dst.data(), dst_size), 0U);
+    EXPECT_EQ(actual, expected);
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  std::vector<int16_t> expected;
+};
+
+TEST_F(SamplesRenderTest, SingleSampleBuffer) { VerifyRender(1); }
+
+TEST_F(SamplesRenderTest, OddSizedBuffer) { VerifyRender(1000); }
+
+TEST_F(SamplesRenderTest, BufferLargerThanChunk) { VerifyRender(44100); }
+
+/// Checks that an attention signal lasting 0 seconds is skipped, both when
+/// generating the message in order and when rendering it from a cursor.
+TEST(samething_core_samples_render, SkipsEmptyAttentionSignal) {
+  const struct samething_core_header header = {
+      .location_codes = {"000000", SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "0015",
+      .originator_code = "WXR",
+      .event_code = "RWT",
+      .callsign = "KEC61/NW",
+      .originator_time = "0011200",
+      .attn_sig_duration = 0,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  static struct samething_core_gen_ctx ctx;
+
+  ctx = {};
+  samething_core_ctx_init(&ctx, &header);
+
+  const size_t num_samples = samething_core_seq_spans_get(&ctx, nullptr);
+
+  std::vector<int16_t> actual(num_samples + 1);
+  EXPECT_EQ(samething_core_samples_render(&ctx, actual.data(), actual.size()),
+            num_samples);
+  actual.resize(num_samples);
+
+  std::vector<int16_t> ranged(num_samples);
+  samething_core_range_render(&ctx, 0, ranged.data(), num_samples);
+  EXPECT_EQ(ranged, actual);
+}
+
+/// Checks that the final chunk reported by samething_core_samples_gen() holds
+/// only what remains of the message.
+TEST_F(SamplesRenderTest, SamplesGenReportsFinalChunkSize) {
+  size_t num_samples;
+  size_t total = 0;
+
+  do {
+    num_samples = samething_core_samples_gen(&ctx, sample_data);
+    total += num_samples;
+  } while (ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM);
+
+  EXPECT_EQ(total, expected.size());
+  EXPECT_EQ(num_samples,
+            expected.size() % SAMETHING_CORE_SAMPLES_NUM_MAX == 0
+                ? SAMETHING_CORE_SAMPLES_NUM_MAX
+                : expected.size() % SAMETHING_CORE_SAMPLES_NUM_MAX);
+}
+
+/// Checks that an empty buffer leaves the generation context untouched.
+TEST_F(SamplesRenderTest, EmptyBufferGeneratesNothing) {
+  EXPECT_EQ(samething_core_samples_render(&ctx, nullptr, 0), 0U);
+  EXPECT_EQ(ctx.cursor.seq_state, SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST);
+}
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_seek() asserts when the generation context
+/// specified is NULL.
+TEST(samething_core_seek, AssertsWhenContextIsNULL) {
+  EXPECT_DEATH({ samething_core_seek(nullptr, 0); }, ".*");
+}
+#endif  // NDEBUG
+
+class SeekTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ctx = {};
+    samething_core_ctx_init(&ctx, &header);
+    samething_core_seq_spans_get(&ctx, spans);
+
+    struct samething_core_gen_ctx ref_ctx = {};
+    samething_core_ctx_init(&ref_ctx, &header);
+
+    while (ref_ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
+      const size_t num_samples =
+          samething_core_samples_gen(&ref_ctx, sample_data);
+
+      expected.insert(expected.end(), sample_data,
+                      &sample_data[num_samples]);
+    }
+  }
+
+  /// Seeks to the sample specified, and checks that everything generated from
+  /// there matches the reference stream.
+  void VerifySeek(const size_t sample_offset) {
+    samething_core_seek(&ctx, sample_offset);
+
+    std::vector<int16_t> actual;
+
+    while (ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
+      const size_t num_samples =
+          samething_core_samples_gen(&ctx, sample_data);
+
+      actual.insert(actual.end(), sample_data,
+                    &sample_data[num_samples]);
+    }
+
+    const size_t start =
+        (sample_offset < expected.size()) ? sample_offset : expected.size();
+
+    ASSERT_EQ(actual.size(), expected.size() - start);
+    EXPECT_TRUE(std::equal(actual.begin(), actual.end(),
+                           expected.begin() + static_cast<long>(start)));
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  struct samething_core_seq_span spans[SAMETHING_CORE_SEQ_STATE_NUM];
+  std::vector<int16_t> expected;
+};
+
+TEST_F(SeekTest, Start) { VerifySeek(0); }
+
+TEST_F(SeekTest, WithinPreamble) { VerifySeek(1000); }
+
+TEST_F(SeekTest, WithinHeaderRun) {
+  // Past the preamble, and not on a bit boundary.
+  VerifySeek(spans[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_SECOND].start +
+             (SAMETHING_CORE_PREAMBLE_NUM + 5) *
+                 SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+                 SAMETHING_CORE_AFSK_SAMPLES_PER_BIT +
+             123);
+}
+
+TEST_F(SeekTest, WithinAttentionSignal) {
+  VerifySeek(spans[SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL].start +
+             SAMETHING_CORE_SAMPLE_RATE * 3 + 17);
+}
+
+TEST_F(SeekTest, WithinEOM) {
+  VerifySeek(spans[SAMETHING_CORE_SEQ_STATE_AFSK_EOM_THIRD].start + 2000);
+}
+
+TEST_F(SeekTest, EveryStateStart) {
+  for (size_t state = 0; state < SAMETHING_CORE_SEQ_STATE_NUM; ++state) {
+    VerifySeek(spans[state].start);
+  }
+}
+
+TEST_F(SeekTest, EveryBitOfHeader) {
+  const size_t start = spans[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_THIRD].start;
+
+  for (size_t offset = 0;
+       offset < spans[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_THIRD].num_samples;
+       offset += SAMETHING_CORE_AFSK_SAMPLES_PER_BIT * 7 + 1) {
+    VerifySeek(start + offset);
+  }
+}
+
+TEST_F(SeekTest, Backwards) {
+  // Seeking works no matter how far along generation already is.
+  for (unsigned int i = 0; i < 40; ++i) {
+    samething_core_samples_gen(&ctx, sample_data);
+  }
+  VerifySeek(54321);
+}
+
+TEST_F(SeekTest, LastSample) { VerifySeek(expected.size() - 1); }
+
+TEST_F(SeekTest, End) {
+  samething_core_seek(&ctx, expected.size());
+  EXPECT_EQ(ctx.cursor.seq_state, SAMETHING_CORE_SEQ_STATE_NUM);
+}
+
+TEST_F(SeekTest, PastEnd) {
+  samething_core_seek(&ctx, expected.size() + 12345);
+  EXPECT_EQ(ctx.cursor.seq_state, SAMETHING_CORE_SEQ_STATE_NUM);
+}
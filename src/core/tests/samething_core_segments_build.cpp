@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_segments_build() asserts when generation
+/// has already started on the context.
+TEST(samething_core_segments_build, AssertsWhenGenerationStarted) {
+  struct samething_core_gen_ctx ctx = {};
+  ctx.cursor.seq_state = SAMETHING_CORE_SEQ_STATE_SILENCE_FIRST;
+
+  std::vector<int16_t> burst(SAMETHING_CORE_HEADER_SAMPLES_NUM_MAX);
+  struct samething_core_segment segments[SAMETHING_CORE_SEGMENTS_NUM_MAX];
+
+  EXPECT_DEATH({ samething_core_segments_build(&ctx, burst.data(), segments); },
+               ".*");
+}
+#endif  // NDEBUG
+
+class SegmentsBuildTest : public ::testing::Test {
+ protected:
+  void SetUp() override { Build(); }
+
+  /// Configures the generation context for the header, and builds the
+  /// segments of its message.
+  void Build() {
+    ctx = {};
+    samething_core_ctx_init(&ctx, &header);
+
+    burst.resize(SAMETHING_CORE_HEADER_SAMPLES_NUM_MAX);
+    num_segments = samething_core_segments_build(&ctx, burst.data(), segments);
+  }
+
+  /// Generates the whole message with samething_core_samples_gen().
+  std::vector<int16_t> Generate() {
+    std::vector<int16_t> samples(samething_core_seq_spans_get(&ctx, nullptr));
+
+    for (std::size_t pos = 0; pos < samples.size();
+         pos += SAMETHING_CORE_SAMPLES_NUM_MAX) {
+      samething_core_samples_gen(&ctx, sample_data);
+
+      for (std::size_t i = 0;
+           (i < SAMETHING_CORE_SAMPLES_NUM_MAX) && (pos + i < samples.size());
+           ++i) {
+        samples[pos + i] = sample_data[i];
+      }
+    }
+    return samples;
+  }
+
+  /// Plays the segments back in order.
+  std::vector<int16_t> Play() const {
+    std::vector<int16_t> samples;
+
+    for (std::size_t i = 0; i < num_segments; ++i) {
+      samples.insert(samples.end(), segments[i].samples,
+                     segments[i].samples + segments[i].num_samples);
+    }
+    return samples;
+  }
+
+  struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 9,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  std::vector<int16_t> burst;
+  struct samething_core_segment segments[SAMETHING_CORE_SEGMENTS_NUM_MAX];
+  std::size_t num_segments;
+};
+
+/// Checks to see if the segments, played back in order, are exactly what
+/// samething_core_samples_gen() generates.
+TEST_F(SegmentsBuildTest, MatchesGeneratedSamples) {
+  EXPECT_EQ(Play(), Generate());
+}
+
+/// Checks to see if repeated segments share their samples rather than being
+/// rendered again.
+TEST_F(SegmentsBuildTest, SharesRepeatedSegments) {
+  const std::size_t silence =
+      SAMETHING_CORE_SILENCE_DURATION * SAMETHING_CORE_SILENCE_SEGMENTS_PER_SEC;
+
+  // 3 header bursts, 3 EOM bursts, SAMETHING_CORE_SILENCE_SEGMENTS_PER_SEC
+  // segments per second of each of the 7 silences and 1 segment per second of
+  // the attention signal.
+  ASSERT_EQ(num_segments, 6 + (7 * silence) + header.attn_sig_duration);
+
+  const std::size_t attn_sig = 3 * (1 + silence);
+  const std::size_t eom = num_segments - 1 - silence;
+
+  EXPECT_EQ(segments[0].samples, burst.data());
+  EXPECT_EQ(segments[1 + silence].samples, burst.data());
+  EXPECT_EQ(segments[2 * (1 + silence)].samples, burst.data());
+  EXPECT_EQ(segments[1].samples, segments[2].samples);
+  EXPECT_EQ(segments[1].samples, segments[2 + silence].samples);
+  EXPECT_EQ(segments[attn_sig + 1].samples, segments[attn_sig].samples);
+  EXPECT_EQ(segments[eom].samples, segments[eom - 1 - silence].samples);
+}
+
+/// Checks to see if the NOAA Weather Radio (NWR) attention signal is split into
+/// SAMETHING_CORE_ATTN_SIG_NWR_SEGMENTS_PER_SEC segments per second, and is
+/// still exactly what samething_core_samples_gen() generates.
+TEST_F(SegmentsBuildTest, SplitsNwrAttentionSignal) {
+  header.attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_NWR;
+  Build();
+
+  ASSERT_EQ(num_segments,
+            6 + (7 * SAMETHING_CORE_SILENCE_DURATION *
+                 SAMETHING_CORE_SILENCE_SEGMENTS_PER_SEC) +
+                (header.attn_sig_duration *
+                 SAMETHING_CORE_ATTN_SIG_NWR_SEGMENTS_PER_SEC));
+  ASSERT_LE(num_segments, SAMETHING_CORE_SEGMENTS_NUM_MAX);
+
+  EXPECT_EQ(Play(), Generate());
+}
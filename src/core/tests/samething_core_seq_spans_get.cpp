@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_core_seq_spans_get() asserts when the generation
+/// context specified is NULL.
+TEST(samething_core_seq_spans_get, AssertsWhenContextIsNULL) {
+  EXPECT_DEATH({ samething_core_seq_spans_get(nullptr, nullptr); }, ".*");
+}
+#endif  // NDEBUG
+
+class SeqSpansGetTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ctx = {};
+    samething_core_ctx_init(&ctx, &header);
+  }
+
+  const struct samething_core_header header = {
+      .location_codes = {"101010", "828282",
+                         SAMETHING_CORE_LOCATION_CODE_END_MARKER},
+      .valid_time_period = "2138",
+      .originator_code = "ORG",
+      .event_code = "RED",
+      .callsign = "XIPHIAS ",
+      .originator_time = "3939393",
+      .attn_sig_duration = 8,
+      .attn_sig_type = SAMETHING_CORE_ATTN_SIG_TYPE_EAS};
+
+  struct samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+};
+
+/// Checks that the length of the message is what generating it yields.
+TEST_F(SeqSpansGetTest, LengthMatchesGeneration) {
+  const size_t num_samples = samething_core_seq_spans_get(&ctx, nullptr);
+
+  size_t generated = 0;
+
+  while (ctx.cursor.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
+    generated += samething_core_samples_gen(&ctx, sample_data);
+  }
+  EXPECT_EQ(num_samples, generated);
+
+  // Generation doesn't change the layout of the message.
+  EXPECT_EQ(samething_core_seq_spans_get(&ctx, nullptr), num_samples);
+}
+
+/// Checks that the spans are contiguous, in order, and of the right length.
+TEST_F(SeqSpansGetTest, SpansAreContiguous) {
+  struct samething_core_seq_span spans[SAMETHING_CORE_SEQ_STATE_NUM];
+
+  const size_t num_samples = samething_core_seq_spans_get(&ctx, spans);
+
+  size_t start = 0;
+
+  for (size_t state = 0; state < SAMETHING_CORE_SEQ_STATE_NUM; ++state) {
+    EXPECT_EQ(spans[state].start, start);
+
+    // A cursor at the start of each span is at the start of its sequence state.
+    struct samething_core_cursor cursor;
+    samething_core_cursor_seek(&ctx, &cursor, spans[state].start);
+
+    EXPECT_EQ(cursor.seq_state, state);
+    EXPECT_EQ(cursor.seq_samples_remaining, spans[state].num_samples);
+    start += spans[state].num_samples;
+  }
+  EXPECT_EQ(start, num_samples);
+
+  EXPECT_EQ(spans[SAMETHING_CORE_SEQ_STATE_ATTENTION_SIGNAL].num_samples,
+            8U * SAMETHING_CORE_SAMPLE_RATE);
+  EXPECT_EQ(spans[SAMETHING_CORE_SEQ_STATE_AFSK_HEADER_FIRST].num_samples,
+            ctx.header_size * SAMETHING_CORE_AFSK_BITS_PER_CHAR *
+                SAMETHING_CORE_AFSK_SAMPLES_PER_BIT);
+}
@@ -34,25 +34,38 @@ extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
   std::abort();
 }
 
-TEST(samething_core_silence_gen, AssertsWhenContextIsNULL) {
-  EXPECT_DEATH({ samething_core_silence_gen(nullptr, 0); }, ".*");
+TEST(samething_core_silence_gen, AssertsWhenDstIsNULL) {
+  EXPECT_DEATH({ samething_core_silence_gen(nullptr, 1); }, ".*");
 }
 #endif  // NDEBUG
 
 TEST(samething_core_silence_gen, GeneratesFullChunkOfSilence) {
-  struct samething_core_gen_ctx ctx = {};
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
 
   // Fill the sample data with a constant to ensure that the data is not already
   // 0.
-  std::memset(ctx.sample_data, 0xAB, sizeof(ctx.sample_data));
+  std::memset(sample_data, 0xAB, sizeof(sample_data));
 
   // Essentially, this just zeroes out the chunk.
+  samething_core_silence_gen(sample_data, SAMETHING_CORE_SAMPLES_NUM_MAX);
+
+  // Check to see if the chunk is entirely 0.
   for (size_t i = 0; i < SAMETHING_CORE_SAMPLES_NUM_MAX; ++i) {
-    samething_core_silence_gen(&ctx, i);
+    EXPECT_EQ(sample_data[i], 0);
   }
+}
+
+TEST(samething_core_silence_gen, GeneratesOnlyRequestedRun) {
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
+  std::memset(sample_data, 0xAB, sizeof(sample_data));
+
+  samething_core_silence_gen(&sample_data[10], 20);
 
-  // Check to see if the chunk is entirely 0.
   for (size_t i = 0; i < SAMETHING_CORE_SAMPLES_NUM_MAX; ++i) {
-    EXPECT_EQ(ctx.sample_data[i], 0);
+    if ((i >= 10) && (i < 30)) {
+      EXPECT_EQ(sample_data[i], 0) << "sample " << i;
+    } else {
+      EXPECT_NE(sample_data[i], 0) << "sample " << i;
+    }
   }
 }
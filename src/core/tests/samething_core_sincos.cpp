@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+#include "tone.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+#endif  // NDEBUG
+
+/// Checks to see if the cosine and sine stay within the documented error bound
+/// across the whole cycle, including either side of every quadrant boundary.
+TEST(samething_core_sincos, StaysWithinErrorBound) {
+  double max_error = 0.0;
+
+  for (uint64_t phase = 0; phase <= UINT32_MAX; phase += 65537U) {
+    for (const uint32_t offset : {0U, 1U, 0x3FFFFFFFU, 0x40000000U}) {
+      const auto p = static_cast<uint32_t>(phase + offset);
+      const double angle = 2.0 * std::acos(-1.0) * (p / 4294967296.0);
+
+      float re;
+      float im;
+      samething_core_sincos(p, &re, &im);
+
+      max_error = std::fmax(
+          max_error, std::fabs(static_cast<double>(re) - std::cos(angle)));
+      max_error = std::fmax(
+          max_error, std::fabs(static_cast<double>(im) - std::sin(angle)));
+    }
+  }
+  EXPECT_LE(max_error, SAMETHING_CORE_SINCOS_ERROR_MAX);
+}
+
+/// Checks to see if the exact quarter cycles come out exact.
+TEST(samething_core_sincos, QuarterCyclesAreExact) {
+  const float expected[4][2] = {{1.0F, 0.0F},
+                                {0.0F, 1.0F},
+                                {-1.0F, 0.0F},
+                                {0.0F, -1.0F}};
+
+  for (uint32_t quadrant = 0; quadrant < 4; ++quadrant) {
+    float re;
+    float im;
+    samething_core_sincos(quadrant << 30, &re, &im);
+
+    EXPECT_NEAR(re, expected[quadrant][0], SAMETHING_CORE_SINCOS_ERROR_MAX);
+    EXPECT_NEAR(im, expected[quadrant][1], SAMETHING_CORE_SINCOS_ERROR_MAX);
+  }
+}
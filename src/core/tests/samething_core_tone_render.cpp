@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/core.h"
+#include "tone.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+TEST(samething_core_tone_render, AssertsWhenTooManySamplesRequested) {
+  int16_t dst[SAMETHING_CORE_TONE_RENDER_MAX + 1];
+  const struct samething_core_tone_step step = {};
+  const struct samething_core_tone tone = {&step, 0,
+                                           SAMETHING_CORE_TONE_GAIN(1.0F)};
+
+  EXPECT_DEATH(
+      {
+        samething_core_tone_render_scalar(
+            dst, SAMETHING_CORE_TONE_RENDER_MAX + 1, &tone, 1);
+      },
+      ".*");
+}
+#endif  // NDEBUG
+
+namespace {
+/// Configures the rotation of an oscillator of the specified frequency.
+struct samething_core_tone_step StepMake(const double freq) noexcept {
+  struct samething_core_tone_step step = {};
+
+#ifdef SAMETHING_CORE_FIXED_POINT
+  step.phase_inc = static_cast<uint32_t>(
+      std::llround(freq / SAMETHING_CORE_SAMPLE_RATE * 4294967296.0));
+#else
+  for (unsigned int i = 0; i <= SAMETHING_CORE_TONE_LANES_MAX; ++i) {
+    const double angle =
+        2.0 * std::acos(-1.0) * freq * i / SAMETHING_CORE_SAMPLE_RATE;
+
+    step.re[i] = static_cast<float>(std::cos(angle));
+    step.im[i] = static_cast<float>(std::sin(angle));
+  }
+#endif  // SAMETHING_CORE_FIXED_POINT
+  return step;
+}
+
+/// Returns every tone kernel the host CPU is able to run.
+std::vector<std::pair<const char *, samething_core_tone_kernel>>
+KernelsGet() noexcept {
+  std::vector<std::pair<const char *, samething_core_tone_kernel>> kernels;
+  kernels.emplace_back("scalar", samething_core_tone_render_scalar);
+
+#ifndef SAMETHING_CORE_FIXED_POINT
+#ifdef __SSE2__
+  kernels.emplace_back("sse2", samething_core_tone_render_sse2);
+#endif  // __SSE2__
+
+#if defined(__x86_64__) || defined(__i386__)
+  if (__builtin_cpu_supports("avx2")) {
+    kernels.emplace_back("avx2", samething_core_tone_render_avx2);
+  }
+#endif  // defined(__x86_64__) || defined(__i386__)
+
+#ifdef __ARM_NEON
+  kernels.emplace_back("neon", samething_core_tone_render_neon);
+#endif  // __ARM_NEON
+#endif  // SAMETHING_CORE_FIXED_POINT
+
+  return kernels;
+}
+}  // namespace
+
+/// Checks to see if every kernel tracks an ideal sum of sines to within a
+/// single quantization step, for every length a kernel could be asked for.
+TEST(samething_core_tone_render, MatchesReferenceSine) {
+  const double freqs[2] = {853.0, 2083.3};
+
+  const struct samething_core_tone_step steps[2] = {StepMake(freqs[0]),
+                                                    StepMake(freqs[1])};
+
+  const struct samething_core_tone tones[2] = {
+      {&steps[0], 0x12345678U, SAMETHING_CORE_TONE_GAIN(0.5F)},
+      {&steps[1], 0xC0000000U, SAMETHING_CORE_TONE_GAIN(0.5F)}};
+
+  for (const auto &[name, kernel] : KernelsGet()) {
+    for (std::size_t num_samples = 1;
+         num_samples <= SAMETHING_CORE_TONE_RENDER_MAX; ++num_samples) {
+      int16_t dst[SAMETHING_CORE_TONE_RENDER_MAX + 1] = {};
+      dst[num_samples] = 0x7AB;
+
+      kernel(dst, num_samples, tones, 2);
+
+      for (std::size_t i = 0; i < num_samples; ++i) {
+        double expected = 0.0;
+
+        for (std::size_t tone = 0; tone < 2; ++tone) {
+          const double cycles = (tones[tone].phase / 4294967296.0) +
+                                (freqs[tone] * static_cast<double>(i) /
+                                 SAMETHING_CORE_SAMPLE_RATE);
+
+          expected += std::sin(2.0 * std::acos(-1.0) * cycles) * 0.5;
+        }
+        EXPECT_NEAR(dst[i], expected * INT16_MAX, 1.5)
+            << name << ", sample " << i << " of " << num_samples;
+      }
+
+      // Nothing past the end of the request should have been touched.
+      EXPECT_EQ(dst[num_samples], 0x7AB) << name;
+    }
+  }
+}
+
+/// Checks to see if every kernel clamps samples which fall outside of the
+/// range of int16_t rather than wrapping them around.
+TEST(samething_core_tone_render, SaturatesOutOfRangeSamples) {
+  const struct samething_core_tone_step step = StepMake(1000.0);
+  const struct samething_core_tone tone = {&step, 0,
+                                           SAMETHING_CORE_TONE_GAIN(2.0F)};
+  const struct samething_core_tone tones[2] = {tone, tone};
+
+  for (const auto &[name, kernel] : KernelsGet()) {
+    int16_t dst[SAMETHING_CORE_TONE_RENDER_MAX];
+    kernel(dst, SAMETHING_CORE_TONE_RENDER_MAX, tones, 2);
+
+    // A 1000 Hz tone peaks roughly every 44 samples, and two of them at 2x
+    // gain go well past full scale.
+    EXPECT_EQ(dst[11], INT16_MAX) << name;
+    EXPECT_EQ(dst[33], INT16_MIN) << name;
+  }
+}
+
+/// Checks to see if the selected kernel is one the host CPU is able to run.
+TEST(samething_core_tone_render, SelectsSupportedKernel) {
+  const samething_core_tone_kernel selected =
+      samething_core_tone_kernel_select();
+
+  bool found = false;
+
+  for (const auto &[name, kernel] : KernelsGet()) {
+    found |= (kernel == selected);
+  }
+  EXPECT_TRUE(found);
+}
@@ -26,6 +26,10 @@
 #include "samething/compiler.h"
 #include "samething/debug.h"
 
+/// The number of samples converted at once when the device wants a format
+/// other than signed 16-bit samples.
+#define SAMETHING_AUDIO_CONVERT_CHUNK_SIZE (1024U)
+
 bool samething_audio_init(void) {
   return SDL_InitSubSystem(SDL_INIT_AUDIO) >= 0;
 }
@@ -79,7 +83,31 @@ bool samething_audio_buffer_play(const struct samething_audio_device *const dev,
                                  const size_t buffer_size) {
   const SDL_AudioDeviceID id = (SDL_AudioDeviceID)(uintptr_t)dev->id;
 
-  return SDL_QueueAudio(id, buffer, (Uint32)(sizeof(int16_t) * buffer_size)) >= 0;
+  if (dev->format == SAMETHING_AUDIO_FORMAT_S16) {
+    return SDL_QueueAudio(id, buffer,
+                          (Uint32)(sizeof(int16_t) * buffer_size)) >= 0;
+  }
+
+  // Convert the audio in chunks small enough to live on the stack; the
+  // widest format we can play is 32 bits per sample.
+  int32_t chunk[SAMETHING_AUDIO_CONVERT_CHUNK_SIZE];
+  const size_t sample_size = samething_audio_format_sample_size(dev->format);
+
+  for (size_t pos = 0; pos < buffer_size;) {
+    size_t num_samples = buffer_size - pos;
+
+    if (num_samples > SAMETHING_AUDIO_CONVERT_CHUNK_SIZE) {
+      num_samples = SAMETHING_AUDIO_CONVERT_CHUNK_SIZE;
+    }
+
+    samething_audio_convert(dev->format, chunk, &buffer[pos], num_samples);
+
+    if (SDL_QueueAudio(id, chunk, (Uint32)(sample_size * num_samples)) < 0) {
+      return false;
+    }
+    pos += num_samples;
+  }
+  return true;
 }
 
 bool samething_audio_open_device(
@@ -90,13 +118,33 @@ bool samething_audio_open_device(
 
   spec.freq = audio_spec->sample_rate;
   spec.samples = audio_spec->samples;
-  spec.channels = 1;
+  spec.channels = (audio_spec->channels != 0) ? audio_spec->channels : 1;
 
   switch (audio_spec->format) {
     case SAMETHING_AUDIO_FORMAT_S16:
       spec.format = AUDIO_S16LSB;
       break;
 
+    case SAMETHING_AUDIO_FORMAT_S32:
+      spec.format = AUDIO_S32LSB;
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_F32:
+      spec.format = AUDIO_F32LSB;
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_U8:
+      spec.format = AUDIO_U8;
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_S24:
+    case SAMETHING_AUDIO_FORMAT_MULAW:
+    case SAMETHING_AUDIO_FORMAT_ALAW:
+      // SDL can't play these; they're only useful for writing out audio.
+      SDL_SetError("Audio format %d is not supported for playback",
+                   (int)audio_spec->format);
+      return false;
+
     default:
       // Unhandled audio format.
       SAMETHING_ASSERT(false);
@@ -112,6 +160,7 @@ bool samething_audio_open_device(
   }
 
   dev->id = (void *)(uintptr_t)audio_device;
+  dev->format = audio_spec->format;
   strncpy(dev->name, name, SAMETHING_AUDIO_DEVICE_NAME_LEN_MAX);
 
   // Enable the audio device.
@@ -0,0 +1,333 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file convert.c
+ * Converts signed 16-bit samples, as generated by the core, to every other
+ * audio format we support.
+ *
+ * Every conversion can be done in place. Conversions to wider formats work
+ * from the end of the buffer towards the start, and conversions to narrower
+ * formats work from the start towards the end; either way, a sample is never
+ * overwritten before it has been read.
+ */
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "samething/frontend/audio.h"
+#include "samething/compiler.h"
+#include "samething/debug.h"
+
+/// The number of samples converted at once by the vectorized conversions.
+#define SAMETHING_AUDIO_CONVERT_BLOCK (8U)
+
+/// Scales a signed 16-bit sample to a full scale of 1.0.
+#define SAMETHING_AUDIO_F32_SCALE (1.0F / 32768.0F)
+
+/// The bias added to the magnitude of a sample before encoding it as mu-law.
+#define SAMETHING_AUDIO_MULAW_BIAS (0x21)
+
+/// The largest magnitude of a sample which can be encoded as mu-law.
+#define SAMETHING_AUDIO_MULAW_CLIP (8159)
+
+/// Converts a sample to G.711 mu-law.
+///
+/// @param sample The sample to convert.
+/// @returns The converted sample.
+static uint8_t samething_audio_mulaw_encode(const int16_t sample) {
+  // mu-law only has 14 bits of resolution.
+  int32_t magnitude = sample >> 2;
+  uint8_t mask = 0xFF;
+
+  if (magnitude < 0) {
+    magnitude = -magnitude;
+    mask = 0x7F;
+  }
+
+  if (magnitude > SAMETHING_AUDIO_MULAW_CLIP) {
+    magnitude = SAMETHING_AUDIO_MULAW_CLIP;
+  }
+  magnitude += SAMETHING_AUDIO_MULAW_BIAS;
+
+  // Segment 0 covers biased magnitudes up to 0x3F, and every segment after it
+  // twice as many as the last.
+  const int segment = (31 - __builtin_clz((unsigned int)magnitude)) - 5;
+
+  if (segment >= 8) {
+    return (uint8_t)(0x7F ^ mask);
+  }
+
+  const int mantissa = (magnitude >> (segment + 1)) & 0x0F;
+
+  return (uint8_t)(((segment << 4) | mantissa) ^ mask);
+}
+
+/// Converts a sample to G.711 A-law.
+///
+/// @param sample The sample to convert.
+/// @returns The converted sample.
+static uint8_t samething_audio_alaw_encode(const int16_t sample) {
+  // A-law only has 13 bits of resolution.
+  int32_t magnitude = sample >> 3;
+  uint8_t mask = 0xD5;
+
+  if (magnitude < 0) {
+    magnitude = -magnitude - 1;
+    mask = 0x55;
+  }
+
+  // Segment 0 covers magnitudes up to 0x1F, and every segment after it twice
+  // as many as the last, up to 0xFFF.
+  const int segment =
+      (magnitude <= 0x1F)
+          ? 0
+          : ((31 - __builtin_clz((unsigned int)magnitude)) - 4);
+  const int mantissa = (segment < 2) ? ((magnitude >> 1) & 0x0F)
+                                     : ((magnitude >> segment) & 0x0F);
+
+  return (uint8_t)(((segment << 4) | mantissa) ^ mask);
+}
+
+/// Converts samples to signed 24-bit samples packed into 3 bytes.
+static void samething_audio_convert_s24(uint8_t *const dst,
+                                        const int16_t *const src,
+                                        const size_t num_samples) {
+  for (size_t i = num_samples; i-- > 0;) {
+    const uint16_t sample = (uint16_t)src[i];
+
+    dst[(i * 3) + 0] = 0;
+    dst[(i * 3) + 1] = (uint8_t)sample;
+    dst[(i * 3) + 2] = (uint8_t)(sample >> 8);
+  }
+}
+
+/// Converts samples to signed 32-bit samples.
+static void samething_audio_convert_s32(uint8_t *const dst,
+                                        const int16_t *const src,
+                                        const size_t num_samples) {
+  size_t i = num_samples;
+
+  for (; (i % SAMETHING_AUDIO_CONVERT_BLOCK) != 0; --i) {
+    const int32_t sample = src[i - 1] * 65536;
+    memcpy(&dst[(i - 1) * sizeof(sample)], &sample, sizeof(sample));
+  }
+
+  for (; i > 0; i -= SAMETHING_AUDIO_CONVERT_BLOCK) {
+    const size_t pos = i - SAMETHING_AUDIO_CONVERT_BLOCK;
+
+#if defined(__SSE2__)
+    const __m128i in =
+        _mm_loadu_si128((const __m128i *)(const void *)&src[pos]);
+    const __m128i zero = _mm_setzero_si128();
+
+    _mm_storeu_si128((__m128i *)(void *)&dst[pos * 4],
+                     _mm_unpacklo_epi16(zero, in));
+    _mm_storeu_si128((__m128i *)(void *)&dst[(pos + 4) * 4],
+                     _mm_unpackhi_epi16(zero, in));
+#elif defined(__ARM_NEON)
+    const int16x8_t in = vld1q_s16(&src[pos]);
+
+    vst1q_u8(&dst[pos * 4],
+             vreinterpretq_u8_s32(vshll_n_s16(vget_low_s16(in), 16)));
+    vst1q_u8(&dst[(pos + 4) * 4],
+             vreinterpretq_u8_s32(vshll_n_s16(vget_high_s16(in), 16)));
+#else
+    int32_t out[SAMETHING_AUDIO_CONVERT_BLOCK];
+
+    for (size_t j = 0; j < SAMETHING_AUDIO_CONVERT_BLOCK; ++j) {
+      out[j] = src[pos + j] * 65536;
+    }
+    memcpy(&dst[pos * 4], out, sizeof(out));
+#endif
+  }
+}
+
+/// Converts samples to 32-bit floating point samples.
+static void samething_audio_convert_f32(uint8_t *const dst,
+                                        const int16_t *const src,
+                                        const size_t num_samples) {
+  size_t i = num_samples;
+
+  for (; (i % SAMETHING_AUDIO_CONVERT_BLOCK) != 0; --i) {
+    const float sample = (float)src[i - 1] * SAMETHING_AUDIO_F32_SCALE;
+    memcpy(&dst[(i - 1) * sizeof(sample)], &sample, sizeof(sample));
+  }
+
+  for (; i > 0; i -= SAMETHING_AUDIO_CONVERT_BLOCK) {
+    const size_t pos = i - SAMETHING_AUDIO_CONVERT_BLOCK;
+
+#if defined(__SSE2__)
+    const __m128i in =
+        _mm_loadu_si128((const __m128i *)(const void *)&src[pos]);
+    const __m128 scale = _mm_set1_ps(SAMETHING_AUDIO_F32_SCALE);
+
+    // Sign extend each half by duplicating it into the top of each lane.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16);
+
+    _mm_storeu_ps((float *)(void *)&dst[pos * 4],
+                  _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps((float *)(void *)&dst[(pos + 4) * 4],
+                  _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+#elif defined(__ARM_NEON)
+    const int16x8_t in = vld1q_s16(&src[pos]);
+
+    const float32x4_t lo =
+        vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(in))),
+                    SAMETHING_AUDIO_F32_SCALE);
+    const float32x4_t hi =
+        vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(in))),
+                    SAMETHING_AUDIO_F32_SCALE);
+
+    vst1q_u8(&dst[pos * 4], vreinterpretq_u8_f32(lo));
+    vst1q_u8(&dst[(pos + 4) * 4], vreinterpretq_u8_f32(hi));
+#else
+    float out[SAMETHING_AUDIO_CONVERT_BLOCK];
+
+    for (size_t j = 0; j < SAMETHING_AUDIO_CONVERT_BLOCK; ++j) {
+      out[j] = (float)src[pos + j] * SAMETHING_AUDIO_F32_SCALE;
+    }
+    memcpy(&dst[pos * 4], out, sizeof(out));
+#endif
+  }
+}
+
+/// Converts samples to unsigned 8-bit samples.
+static void samething_audio_convert_u8(uint8_t *const dst,
+                                       const int16_t *const src,
+                                       const size_t num_samples) {
+  const size_t num_blocks = num_samples / SAMETHING_AUDIO_CONVERT_BLOCK;
+  size_t i = 0;
+
+  for (size_t block = 0; block < num_blocks; ++block) {
+#if defined(__SSE2__)
+    const __m128i in = _mm_loadu_si128((const __m128i *)(const void *)&src[i]);
+    const __m128i out =
+        _mm_xor_si128(_mm_packs_epi16(_mm_srai_epi16(in, 8), in),
+                      _mm_set1_epi8((char)0x80));
+
+    _mm_storel_epi64((__m128i *)(void *)&dst[i], out);
+#elif defined(__ARM_NEON)
+    const int8x8_t out = vshrn_n_s16(vld1q_s16(&src[i]), 8);
+
+    vst1_u8(&dst[i], veor_u8(vreinterpret_u8_s8(out), vdup_n_u8(0x80)));
+#else
+    uint8_t out[SAMETHING_AUDIO_CONVERT_BLOCK];
+
+    for (size_t j = 0; j < SAMETHING_AUDIO_CONVERT_BLOCK; ++j) {
+      out[j] = (uint8_t)(((uint16_t)src[i + j] >> 8) ^ 0x80);
+    }
+    memcpy(&dst[i], out, sizeof(out));
+#endif
+    i += SAMETHING_AUDIO_CONVERT_BLOCK;
+  }
+
+  for (; i < num_samples; ++i) {
+    dst[i] = (uint8_t)(((uint16_t)src[i] >> 8) ^ 0x80);
+  }
+}
+
+size_t samething_audio_format_sample_size(
+    const enum samething_audio_format format) {
+  switch (format) {
+    case SAMETHING_AUDIO_FORMAT_S16:
+      return sizeof(int16_t);
+
+    case SAMETHING_AUDIO_FORMAT_S24:
+      return 3;
+
+    case SAMETHING_AUDIO_FORMAT_S32:
+      return sizeof(int32_t);
+
+    case SAMETHING_AUDIO_FORMAT_F32:
+      return sizeof(float);
+
+    case SAMETHING_AUDIO_FORMAT_U8:
+    case SAMETHING_AUDIO_FORMAT_MULAW:
+    case SAMETHING_AUDIO_FORMAT_ALAW:
+      return sizeof(uint8_t);
+
+    default:
+      // Unhandled audio format.
+      SAMETHING_ASSERT(false);
+      SAMETHING_UNREACHABLE;
+      return 0;
+  }
+}
+
+void samething_audio_convert(const enum samething_audio_format format,
+                             void *const dst, const int16_t *const src,
+                             const size_t num_samples) {
+  SAMETHING_ASSERT((dst != NULL) || (num_samples == 0));
+  SAMETHING_ASSERT((src != NULL) || (num_samples == 0));
+
+  if (num_samples == 0) {
+    return;
+  }
+
+  uint8_t *const out = dst;
+
+  switch (format) {
+    case SAMETHING_AUDIO_FORMAT_S16:
+      memmove(out, src, num_samples * sizeof(int16_t));
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_S24:
+      samething_audio_convert_s24(out, src, num_samples);
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_S32:
+      samething_audio_convert_s32(out, src, num_samples);
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_F32:
+      samething_audio_convert_f32(out, src, num_samples);
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_U8:
+      samething_audio_convert_u8(out, src, num_samples);
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_MULAW:
+      for (size_t i = 0; i < num_samples; ++i) {
+        out[i] = samething_audio_mulaw_encode(src[i]);
+      }
+      break;
+
+    case SAMETHING_AUDIO_FORMAT_ALAW:
+      for (size_t i = 0; i < num_samples; ++i) {
+        out[i] = samething_audio_alaw_encode(src[i]);
+      }
+      break;
+
+    default:
+      // Unhandled audio format.
+      SAMETHING_ASSERT(false);
+      SAMETHING_UNREACHABLE;
+      break;
+  }
+}
@@ -30,6 +30,7 @@ extern "C" {
 #endif  // __cplusplus
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /// The maximum number of playback audio devices that we support.
@@ -38,6 +39,33 @@ extern "C" {
 /// The maximum length an audio device name can be.
 #define SAMETHING_AUDIO_DEVICE_NAME_LEN_MAX (128)
 
+/// Defines the audio formats we support.
+enum samething_audio_format {
+  /// Signed 16-bit samples in little-endian byte order.
+  SAMETHING_AUDIO_FORMAT_S16,
+
+  /// Signed 24-bit samples packed into 3 bytes in little-endian byte order.
+  SAMETHING_AUDIO_FORMAT_S24,
+
+  /// Signed 32-bit samples in little-endian byte order.
+  SAMETHING_AUDIO_FORMAT_S32,
+
+  /// 32-bit floating point samples, with a full scale of 1.0.
+  SAMETHING_AUDIO_FORMAT_F32,
+
+  /// Unsigned 8-bit samples, where 128 is silence.
+  SAMETHING_AUDIO_FORMAT_U8,
+
+  /// 8-bit G.711 mu-law samples.
+  SAMETHING_AUDIO_FORMAT_MULAW,
+
+  /// 8-bit G.711 A-law samples.
+  SAMETHING_AUDIO_FORMAT_ALAW,
+
+  /// The number of audio formats we support.
+  SAMETHING_AUDIO_FORMAT_NUM
+};
+
 /// Defines an audio device.
 struct samething_audio_device {
   /// The actual name of the audio device.
@@ -46,12 +74,9 @@ struct samething_audio_device {
   /// Native handle to the audio device, whatever that might be. This is not for
   /// your use; it is internal to the audio module.
   void *id;
-};
 
-/// Defines the audio formats we support.
-enum samething_audio_format {
-  /// Signed 16-bit samples in little-endian byte order.
-  SAMETHING_AUDIO_FORMAT_S16
+  /// The audio format the device was opened with.
+  enum samething_audio_format format;
 };
 
 /// Defines the specification of the audio we plan to submit to the audio
@@ -65,6 +90,10 @@ struct samething_audio_spec {
 
   /// The size of the audio buffer in sample frames. This must be a power of 2.
   uint16_t samples;
+
+  /// The number of interleaved channels in each sample frame. 0 is treated as
+  /// 1, for mono.
+  uint8_t channels;
 };
 
 /// Initializes the audio module.
@@ -107,11 +136,34 @@ bool samething_audio_open_device(
     const char *const name, struct samething_audio_device *const dev,
     const struct samething_audio_spec *const audio_spec);
 
-/// Sends audio data to the device.
+/// Retrieves the size of a sample in an audio format.
+///
+/// @param format The audio format.
+/// @returns The size of a sample in bytes.
+size_t samething_audio_format_sample_size(
+    const enum samething_audio_format format);
+
+/// Converts signed 16-bit samples to another audio format.
+///
+/// The conversion may be done in place, in which case \p dst must be the same
+/// as \p src and large enough to hold the converted samples.
+///
+/// @param format The audio format to convert to.
+/// @param dst The buffer to store the converted samples in. It must hold at
+/// least \p num_samples samples of \p format.
+/// @param src The samples to convert.
+/// @param num_samples The number of samples to convert.
+void samething_audio_convert(const enum samething_audio_format format,
+                             void *const dst, const int16_t *const src,
+                             const size_t num_samples);
+
+/// Sends audio data to the device, converting it to the format the device was
+/// opened with.
 ///
 /// @param dev The audio device to feed data to.
 /// @param buffer The audio data to feed.
-/// @param buffer_size The size of the audio data.
+/// @param buffer_size The size of the audio data, in samples. For more than
+/// one channel, this counts every sample of every frame.
 /// @returns true if this operation was successful, or false otherwise.
 bool samething_audio_buffer_play(const struct samething_audio_device *const dev,
                                  const int16_t *const buffer,
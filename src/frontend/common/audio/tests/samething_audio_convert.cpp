@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: MIT
+//
+// Copyright 2023 Michael Rodriguez
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "samething/frontend/audio.h"
+
+#ifndef NDEBUG
+extern "C" void *samething_dbg_userdata_ = nullptr;
+
+extern "C" [[noreturn]] void samething_dbg_assert_failed(const char *const,
+                                                         const char *const,
+                                                         const int, void *) {
+  std::abort();
+}
+
+/// Checks to see if samething_audio_convert() asserts when the destination
+/// buffer is NULL.
+TEST(samething_audio_convert, AssertsWhenDestinationIsNULL) {
+  const int16_t src[1] = {};
+
+  EXPECT_DEATH(
+      { samething_audio_convert(SAMETHING_AUDIO_FORMAT_S32, nullptr, src, 1); },
+      ".*");
+}
+
+/// Checks to see if samething_audio_convert() asserts when the audio format is
+/// invalid.
+TEST(samething_audio_convert, AssertsWhenFormatIsInvalid) {
+  int16_t buf[1] = {};
+
+  EXPECT_DEATH(
+      {
+        samething_audio_convert(SAMETHING_AUDIO_FORMAT_NUM, buf, buf, 1);
+      },
+      ".*");
+}
+#endif  // NDEBUG
+
+namespace {
+
+/// Segment end points of the G.711 reference encoders.
+constexpr int16_t kMuLawSegEnds[] = {0x3F,  0x7F,  0xFF,  0x1FF,
+                                     0x3FF, 0x7FF, 0xFFF, 0x1FFF};
+constexpr int16_t kALawSegEnds[] = {0x1F,  0x3F,  0x7F,  0xFF,
+                                    0x1FF, 0x3FF, 0x7FF, 0xFFF};
+
+int SegmentSearch(const int value, const int16_t *const table) {
+  for (int i = 0; i < 8; ++i) {
+    if (value <= table[i]) {
+      return i;
+    }
+  }
+  return 8;
+}
+
+/// Reference mu-law encoder, after the Sun Microsystems G.711 sources.
+uint8_t MuLawReference(const int16_t sample) {
+  int pcm = sample >> 2;
+  int mask = 0xFF;
+
+  if (pcm < 0) {
+    pcm = -pcm;
+    mask = 0x7F;
+  }
+  if (pcm > 8159) {
+    pcm = 8159;
+  }
+  pcm += 0x84 >> 2;
+
+  const int seg = SegmentSearch(pcm, kMuLawSegEnds);
+
+  if (seg >= 8) {
+    return static_cast<uint8_t>(0x7F ^ mask);
+  }
+  return static_cast<uint8_t>(((seg << 4) | ((pcm >> (seg + 1)) & 0xF)) ^
+                              mask);
+}
+
+/// Reference A-law encoder, after the Sun Microsystems G.711 sources.
+uint8_t ALawReference(const int16_t sample) {
+  int pcm = sample >> 3;
+  int mask = 0xD5;
+
+  if (pcm < 0) {
+    mask = 0x55;
+    pcm = -pcm - 1;
+  }
+
+  const int seg = SegmentSearch(pcm, kALawSegEnds);
+
+  if (seg >= 8) {
+    return static_cast<uint8_t>(0x7F ^ mask);
+  }
+
+  int aval = seg << 4;
+
+  aval |= (seg < 2) ? ((pcm >> 1) & 0xF) : ((pcm >> seg) & 0xF);
+  return static_cast<uint8_t>(aval ^ mask);
+}
+
+/// Returns every possible signed 16-bit sample.
+std::vector<int16_t> AllSamples() {
+  std::vector<int16_t> samples;
+
+  for (int32_t i = INT16_MIN; i <= INT16_MAX; ++i) {
+    samples.push_back(static_cast<int16_t>(i));
+  }
+  return samples;
+}
+
+/// Converts \p src to \p format into a new buffer.
+std::vector<uint8_t> Convert(const enum samething_audio_format format,
+                             const std::vector<int16_t> &src) {
+  std::vector<uint8_t> dst(src.size() *
+                           samething_audio_format_sample_size(format));
+
+  if (src.empty()) {
+    return dst;
+  }
+
+  samething_audio_convert(format, dst.data(), src.data(), src.size());
+  return dst;
+}
+
+}  // namespace
+
+/// Checks to see if the sample sizes are correct.
+TEST(samething_audio_convert, SampleSizes) {
+  EXPECT_EQ(samething_audio_format_sample_size(SAMETHING_AUDIO_FORMAT_S16), 2);
+  EXPECT_EQ(samething_audio_format_sample_size(SAMETHING_AUDIO_FORMAT_S24), 3);
+  EXPECT_EQ(samething_audio_format_sample_size(SAMETHING_AUDIO_FORMAT_S32), 4);
+  EXPECT_EQ(samething_audio_format_sample_size(SAMETHING_AUDIO_FORMAT_F32), 4);
+  EXPECT_EQ(samething_audio_format_sample_size(SAMETHING_AUDIO_FORMAT_U8), 1);
+  EXPECT_EQ(samething_audio_format_sample_size(SAMETHING_AUDIO_FORMAT_MULAW),
+            1);
+  EXPECT_EQ(samething_audio_format_sample_size(SAMETHING_AUDIO_FORMAT_ALAW),
+            1);
+}
+
+/// Checks every sample against a reference conversion for each format.
+TEST(samething_audio_convert, MatchesReference) {
+  const std::vector<int16_t> src = AllSamples();
+
+  const std::vector<uint8_t> s16 = Convert(SAMETHING_AUDIO_FORMAT_S16, src);
+  const std::vector<uint8_t> s24 = Convert(SAMETHING_AUDIO_FORMAT_S24, src);
+  const std::vector<uint8_t> s32 = Convert(SAMETHING_AUDIO_FORMAT_S32, src);
+  const std::vector<uint8_t> f32 = Convert(SAMETHING_AUDIO_FORMAT_F32, src);
+  const std::vector<uint8_t> u8 = Convert(SAMETHING_AUDIO_FORMAT_U8, src);
+  const std::vector<uint8_t> mulaw = Convert(SAMETHING_AUDIO_FORMAT_MULAW, src);
+  const std::vector<uint8_t> alaw = Convert(SAMETHING_AUDIO_FORMAT_ALAW, src);
+
+  for (size_t i = 0; i < src.size(); ++i) {
+    const int16_t sample = src[i];
+    const uint16_t bits = static_cast<uint16_t>(sample);
+
+    int16_t s16_actual;
+    std::memcpy(&s16_actual, &s16[i * 2], sizeof(s16_actual));
+    ASSERT_EQ(s16_actual, sample);
+
+    ASSERT_EQ(s24[(i * 3) + 0], 0);
+    ASSERT_EQ(s24[(i * 3) + 1], bits & 0xFF);
+    ASSERT_EQ(s24[(i * 3) + 2], bits >> 8);
+
+    int32_t s32_actual;
+    std::memcpy(&s32_actual, &s32[i * 4], sizeof(s32_actual));
+    ASSERT_EQ(s32_actual, sample * 65536);
+
+    float f32_actual;
+    std::memcpy(&f32_actual, &f32[i * 4], sizeof(f32_actual));
+    ASSERT_EQ(f32_actual, static_cast<float>(sample) / 32768.0F);
+
+    ASSERT_EQ(u8[i], (bits >> 8) ^ 0x80);
+    ASSERT_EQ(mulaw[i], MuLawReference(sample)) << "sample " << sample;
+    ASSERT_EQ(alaw[i], ALawReference(sample)) << "sample " << sample;
+  }
+}
+
+/// Checks to see if silence converts to each format's notion of silence.
+TEST(samething_audio_convert, Silence) {
+  const std::vector<int16_t> src(1, 0);
+
+  EXPECT_EQ(Convert(SAMETHING_AUDIO_FORMAT_U8, src)[0], 0x80);
+  EXPECT_EQ(Convert(SAMETHING_AUDIO_FORMAT_MULAW, src)[0], 0xFF);
+  EXPECT_EQ(Convert(SAMETHING_AUDIO_FORMAT_ALAW, src)[0], 0xD5);
+}
+
+/// Checks to see if converting in place matches converting into a separate
+/// buffer, for lengths which don't fill a whole number of vector blocks.
+TEST(samething_audio_convert, InPlaceMatchesOutOfPlace) {
+  for (int format = 0; format < SAMETHING_AUDIO_FORMAT_NUM; ++format) {
+    const auto fmt = static_cast<enum samething_audio_format>(format);
+
+    for (size_t num_samples = 1; num_samples <= 37; ++num_samples) {
+      std::vector<int16_t> src(num_samples);
+
+      for (size_t i = 0; i < num_samples; ++i) {
+        src[i] = static_cast<int16_t>((i * 7919) - 16000);
+      }
+
+      const std::vector<uint8_t> expected = Convert(fmt, src);
+
+      // Large enough for the widest format.
+      std::vector<int16_t> buf(num_samples * 2);
+      std::copy(src.begin(), src.end(), buf.begin());
+
+      samething_audio_convert(fmt, buf.data(), buf.data(), num_samples);
+
+      ASSERT_EQ(std::memcmp(buf.data(), expected.data(), expected.size()), 0)
+          << "format " << format << ", " << num_samples << " samples";
+    }
+  }
+}
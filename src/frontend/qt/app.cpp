@@ -273,14 +273,14 @@ void SAMEthingApp::SAMEHeaderPlay(samething_core_header& header) noexcept {
     return;
   }
 
-  samething_core_gen_ctx ctx = {};
+  samething_core_gen_ctx ctx;
+  int16_t sample_data[SAMETHING_CORE_SAMPLES_NUM_MAX];
   samething_core_ctx_init(&ctx, &header);
 
-  while (ctx.seq_state != SAMETHING_CORE_SEQ_STATE_NUM) {
-    samething_core_samples_gen(&ctx);
+  while (ctx.cursor.seq_state < ctx.seq_plan_size) {
+    const size_t num_samples = samething_core_samples_gen(&ctx, sample_data);
 
-    if (!samething_audio_buffer_play(&dev, ctx.sample_data,
-                                     SAMETHING_CORE_SAMPLES_NUM_MAX)) {
+    if (!samething_audio_buffer_play(&dev, sample_data, num_samples)) {
       // Error!
       return;
     }